@@ -4,19 +4,55 @@
 #include "autobahn_common.h"
 
 /* Addition and Subtraction */
+void bigint_addition_unsigned(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+void bigint_subtraction_unsigned(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
 void bigint_addition(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
 void bigint_subtraction(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+void bigint_addition_unsigned_inplace(Bigint** bigint, const Bigint* operand);
+void bigint_subtraction_unsigned_inplace(Bigint** bigint, const Bigint* operand);
+void bigint_addition_inplace(Bigint** bigint, const Bigint* operand);
+void bigint_subtraction_inplace(Bigint** bigint, const Bigint* operand);
+void bigint_addition_word(Bigint** result, const Bigint* bigint, Word word);
+void bigint_subtraction_word(Bigint** result, const Bigint* bigint, Word word);
+void bigint_addition_word_inplace(Bigint** bigint, Word word);
+void bigint_subtraction_word_inplace(Bigint** bigint, Word word);
 
 /* Multiplication and Squaring */
 void bigint_multiplication_textbook(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+void bigint_multiplication_comba(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
 void bigint_multiplication_karatsuba(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+void bigint_multiplication_unbalanced(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+void bigint_multiplication_word(Bigint** result, const Bigint* bigint, Word word);
+void bigint_multiplication_word_inplace(Bigint** bigint, Word word);
+void bigint_squaring_textbook(Bigint** result, const Bigint* operand);
+void bigint_squaring_karatsuba(Bigint** result, const Bigint* operand);
+void bigint_squaring(Bigint** result, const Bigint* operand);
+void bigint_multiplication_toom(Bigint** result, const Bigint* operand_x, const Bigint* operand_y, size_t parts_x, size_t parts_y);
+void bigint_multiplication_toom3(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+void bigint_multiplication_toom4(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+void bigint_multiplication_ntt(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+void bigint_multiplication(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+
+/* Thresholds of multiplication, squaring and division */
+void bigint_get_thresholds(Thresholds* thresholds);
+void bigint_set_thresholds(const Thresholds* thresholds);
+char bigint_save_thresholds(const char* file_path);
+char bigint_load_thresholds(const char* file_path);
 
 /* Division and Reduction */
 void bigint_division_binary_long(Bigint** quotient, Bigint** remainder, const Bigint* dividend, const Bigint* divisor);
 void bigint_division_naive(Bigint** quotient, Bigint** remainder, const Bigint* dividend, const Bigint* divisor);
 void bigint_reduction_barrett_pre_computed(Bigint** barrett_pre_computed, const Bigint* modular);
 void bigint_reduction_barrett(Bigint** result, const Bigint* bigint, const Bigint* modular, const Bigint* pre_computed);
+void bigint_reduction_barrett_inplace(Bigint** bigint, const Bigint* modular, const Bigint* pre_computed);
 void bigint_division_word_long(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor);
+void bigint_division_burnikel_ziegler(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor);
+void bigint_reciprocal(Bigint **reciprocal, const Bigint *divisor, size_t power);
+void bigint_division_newton(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor);
+void bigint_division(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor);
+Word bigint_division_word(Bigint **quotient, const Bigint *dividend, Word divisor);
+Word bigint_division_word_inplace(Bigint **bigint, Word divisor);
+Word bigint_reduction_word(const Bigint *bigint, Word modular);
 
 /* Exponentiation */
 void bigint_exponentiation_left_to_right(Bigint** result, const Bigint* base, const Bigint* exponent);
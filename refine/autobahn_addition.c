@@ -1,130 +1,210 @@
 #include "autobahn.h"
+#include "autobahn_kernel.h"
 
 /**
- * @brief Performs addition of two words with a carry and determines the next carry.
- * 
- * This function adds the values of [operand_x] and [operand_y] along with the [current_carry].
- * The result is stored in [result], and the function sets [next_carry] if overflow occurs.
+ * @brief Performs unsigned addition of two large integers.
  * 
- * carry condition : let r = x + y. if r < x(or y) then carry is set.
+ * This function adds the values of [operand_x] and [operand_y] and stores the result in [result].
+ * It is assumed that [operand_x] is larger than or equal to [operand_y].
+ * The operands may have different numbers of digits and are not modified.
  * 
  * @param result [output] Result of the addition.
- * @param next_carry [output] Carry from the current addition.
- * @param current_carry [input] Carry from the previous addition.
  * @param operand_x [input] First operand of the addition.
  * @param operand_y [input] Second operand of the addition.
  */
-static void word_addition_with_carry(Word* result, Word* next_carry, Word current_carry, Word operand_x, Word operand_y) 
+void bigint_addition_unsigned(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
 {
-    *result     = operand_x + operand_y;        // r = x + y
-    *next_carry = (*result < operand_x);        // set carry
-    *result     += current_carry;               // r = x + y + c
-    *next_carry += (*result < current_carry);   // set carry
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with an operand.
+
+    /* Allocate Bigint */
+    Bigint** output = bigint_output_new(result, &tmp_result, operand_x->digit_num + 1, operand_x, operand_y);
+
+    /* Addition word by word, then set the final carry */
+    (*output)->digits[operand_x->digit_num] = word_array_add((*output)->digits,
+                                                             operand_x->digits, operand_x->digit_num,
+                                                             operand_y->digits, operand_y->digit_num);
+
+    /* Get result */
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
+
+    /* Free Bigint */
+    bigint_scratch_release(mark);
 }
 
 /**
- * @brief Performs unsigned addition of two large integers.
+ * @brief Performs addition of two large integers.
  * 
  * This function adds the values of [operand_x] and [operand_y] and stores the result in [result].
- * It is assumed that [operand_x] is larger than or equal to [operand_y].
  * 
  * @param result [output] Result of the addition.
  * @param operand_x [input] First operand of the addition.
  * @param operand_y [input] Second operand of the addition.
  */
-void bigint_addition_unsigned(Bigint** result, Bigint* operand_x, Bigint* operand_y)
+void bigint_addition(Bigint** result, const Bigint* operand_x, const Bigint* operand_y) 
 {
-    Word current_carry = 0;
-    Word next_carry = 0;
-    Bigint* tmp_result = NULL;  // This will be the result.
+    /* Case: result = operand_x + (-operand_y) or (-operand_x) + operand_y */
+    if (operand_x->sign != operand_y->sign) 
+    {
+        char who_is_big = bigint_compare_abs(operand_x, operand_y);
+
+        /* Case: |operand_x| == |operand_y| */
+        if (who_is_big == SAME) {
+            bigint_set_zero(result);
+            return;
+        }
+
+        /* The result has the sign of the operand with the larger absolute value */
+        if (who_is_big == LEFT_IS_BIG) {
+            Sign result_sign = operand_x->sign; // [result] may be the same object as an operand.
+            bigint_subtraction_unsigned(result, operand_x, operand_y);
+            (*result)->sign = result_sign;
+        } else {
+            Sign result_sign = operand_y->sign;
+            bigint_subtraction_unsigned(result, operand_y, operand_x);
+            (*result)->sign = result_sign;
+        }
+
+        return;
+    }
+
+    /* Perform addition: the longer operand goes first */
+    Sign result_sign = operand_x->sign;
+
+    if (operand_x->digit_num >= operand_y->digit_num)
+        bigint_addition_unsigned(result, operand_x, operand_y);
+    else
+        bigint_addition_unsigned(result, operand_y, operand_x);
     
+    /* Set the sign of the result */
+    (*result)->sign = result_sign;
+}
 
+/**
+ * @brief Adds the absolute value of [operand] to the absolute value of [bigint] in place.
+ * 
+ * |bigint| <- |bigint| + |operand|. The sign of [bigint] is not changed.
+ * [bigint] grows only if its capacity is not large enough for the carry.
+ * [operand] must not be aliased with [bigint].
+ * 
+ * @param bigint [input/output] Memory address of the large integer to update.
+ * @param operand [input] Operand of the addition.
+ */
+void bigint_addition_unsigned_inplace(Bigint** bigint, const Bigint* operand)
+{
+    assert(!bigint_is_aliased(*bigint, operand));
 
-    /* Make operands have the same number of digits */  // !!         
-    if (operand_y->digit_num != operand_x->digit_num)
-    {
-        Word previous_digit_num = operand_y->digit_num; // !!     
-        operand_y->digits = (Word*)realloc(operand_y->digits, operand_x->digit_num * SIZE_OF_WORD);
-        operand_y->digit_num = operand_x->digit_num;
+    size_t digit_num = ((*bigint)->digit_num > operand->digit_num) ? (*bigint)->digit_num : operand->digit_num;
 
-        for (int i = operand_y->digit_num; i > previous_digit_num; i--) // !!
-            operand_y->digits[i - 1] = 0;
-    }
+    /* Pad with zero digits and room for the carry */
+    bigint_resize(bigint, digit_num + 1);
 
+    /* Addition word by word: the kernel may write over its first operand */
+    (*bigint)->digits[digit_num] = word_array_add((*bigint)->digits, (*bigint)->digits, digit_num,
+                                                  operand->digits, operand->digit_num);
 
-    /* Allocate Bigint */
-    bigint_new(&tmp_result, operand_x->digit_num + 1);
+    bigint_refine(*bigint);
+}
 
-    /* Addition word by word */
-    for (size_t idx = 0; idx < operand_x->digit_num; idx++) {
-        word_addition_with_carry(&(tmp_result->digits[idx]), &next_carry, current_carry, operand_x->digits[idx], operand_y->digits[idx]);
-        current_carry = next_carry; // Update the carry.
+/**
+ * @brief Adds a large integer to another large integer in place.
+ * 
+ * [bigint] <- [bigint] + [operand], without allocating a new result.
+ * This is the entry point for accumulation loops such as summing partial products.
+ * 
+ * Aliasing: [operand] may be *[bigint] itself (the value is doubled), but it must not
+ * otherwise share digits with *[bigint] (for example, a view of it). Debug builds check this.
+ * 
+ * @param bigint [input/output] Memory address of the large integer to update.
+ * @param operand [input] Operand of the addition.
+ */
+void bigint_addition_inplace(Bigint** bigint, const Bigint* operand)
+{
+    /* Case: x += x */
+    if (*bigint == operand) {
+        bigint_shift_left_inplace(bigint, 1);
+        return;
     }
-    
-    /* Set the final carry */
-    tmp_result->digits[operand_x->digit_num] = current_carry;
 
-    /* Get result */
-    bigint_refine(operand_y);
-    bigint_refine(tmp_result);
-    bigint_copy(result, tmp_result);
+    assert(!bigint_is_aliased(*bigint, operand));
 
-    /* Free Bigint */
-    bigint_delete(&tmp_result);
-}
+    /* Case: same signs */
+    if ((*bigint)->sign == operand->sign) {
+        bigint_addition_unsigned_inplace(bigint, operand);
+        return;
+    }
+
+    /* Case: different signs, the larger absolute value gives the sign */
+    char who_is_big = bigint_compare_abs(*bigint, operand);
+
+    bigint_subtraction_unsigned_inplace(bigint, operand);
 
+    if (who_is_big == LEFT_IS_SMALL) (*bigint)->sign = operand->sign;
+    if (who_is_big == SAME) (*bigint)->sign = POSITIVE;
+}
 /**
- * @brief Performs addition of two large integers.
+ * @brief Adds a single word to a large integer.
  * 
- * This function adds the values of [operand_x] and [operand_y] and stores the result in [result].
+ * [result] <- [bigint] + [word] in one pass over the digits: the carry is
+ * propagated only until it dies, and the rest of the digits are copied.
+ * [result] may be the same object as [bigint].
  * 
  * @param result [output] Result of the addition.
- * @param operand_x [input] First operand of the addition.
- * @param operand_y [input] Second operand of the addition.
+ * @param bigint [input] Large integer operand.
+ * @param word [input] Word to add.
  */
-void bigint_addition(Bigint** result, const Bigint* operand_x, const Bigint* operand_y) 
+void bigint_addition_word(Bigint** result, const Bigint* bigint, Word word)
 {
-    /* Use temporary variables to avoid modifying the input operands */
-    Bigint* tmp_x = NULL;
-    Bigint* tmp_y = NULL;
+    /* Case: (-x) + word = -(x - word) */
+    if (bigint->sign == NEGATIVE) {
+        Bigint magnitude = bigint_view(bigint->digits, bigint->digit_num, POSITIVE); // |x|, no copy
+        bigint_subtraction_word(result, &magnitude, word);
+        (*result)->sign = ((*result)->sign == POSITIVE && !bigint_is_zero(*result)) ? NEGATIVE : POSITIVE;
+        return;
+    }
+
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with [bigint].
 
     /* Allocate Bigint */
-    bigint_new(&tmp_x, operand_x->digit_num);
-    bigint_new(&tmp_y, operand_y->digit_num);
-
-    /* Input Operands */
-    bigint_copy(&tmp_x, operand_x);
-    bigint_copy(&tmp_y, operand_y);
-
-    /* Case: result = operand_x + (-operand_y) */
-    if ((tmp_x->sign == POSITIVE && tmp_y->sign == NEGATIVE)) {
-        tmp_y->sign = POSITIVE;
-        bigint_subtraction(result, tmp_x, tmp_y);
-        goto RETURN;
-    }
-    
-    /* Case: result = (-operand_x) + operand_y */
-    if (tmp_x->sign == NEGATIVE && tmp_y->sign == POSITIVE) {
-        tmp_x->sign = POSITIVE;
-        bigint_subtraction(result, tmp_y, tmp_x);
-        goto RETURN;
-    }
+    Bigint** output = bigint_output_new(result, &tmp_result, bigint->digit_num + 1, bigint, NULL);
 
-    /* Perform addition */
-    if (bigint_compare_abs(tmp_x, tmp_y) == 1)
-        bigint_addition_unsigned(result, tmp_x, tmp_y);
-    else
-        bigint_addition_unsigned(result, tmp_y, tmp_x);
-    
-    /* Set the sign of the result */
-    if (tmp_x->sign == POSITIVE && tmp_y->sign == POSITIVE) (*result)->sign = POSITIVE;
-    if (tmp_x->sign == NEGATIVE && tmp_y->sign == NEGATIVE) (*result)->sign = NEGATIVE;
+    /* Addition, then set the final carry */
+    (*output)->digits[bigint->digit_num] = word_array_add_1((*output)->digits, bigint->digits, bigint->digit_num, word);
 
-    RETURN:
+    /* Get result */
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
 
     /* Free Bigint */
-    bigint_delete(&tmp_x);
-    bigint_delete(&tmp_y);
+    bigint_scratch_release(mark);
+}
 
-    return;
+/**
+ * @brief Adds a single word to a large integer in place.
+ * 
+ * [bigint] <- [bigint] + [word], without allocating a new result.
+ * [bigint] grows by one digit only if the carry runs out of the top digit.
+ * 
+ * @param bigint [input/output] Memory address of the large integer to update.
+ * @param word [input] Word to add.
+ */
+void bigint_addition_word_inplace(Bigint** bigint, Word word)
+{
+    /* Case: (-x) + word = -(x - word) */
+    if ((*bigint)->sign == NEGATIVE) {
+        (*bigint)->sign = POSITIVE;
+        bigint_subtraction_word_inplace(bigint, word);
+        (*bigint)->sign = ((*bigint)->sign == POSITIVE && !bigint_is_zero(*bigint)) ? NEGATIVE : POSITIVE;
+        return;
+    }
+
+    size_t digit_num = (*bigint)->digit_num;
+    Word carry = word_array_add_1((*bigint)->digits, (*bigint)->digits, digit_num, word);
+
+    if (carry) {
+        bigint_resize(bigint, digit_num + 1);
+        (*bigint)->digits[digit_num] = carry;
+    }
 }
@@ -1,4 +1,333 @@
 #include "autobahn_common.h"
+#include "autobahn_kernel.h"
+
+#if defined(_MSC_VER)
+    #define THREAD_LOCAL __declspec(thread)
+#else
+    #define THREAD_LOCAL _Thread_local
+#endif
+
+/* The digits start at the first Word-aligned offset after the Bigint structure */
+#define BIGINT_HEADER_SIZE ((SIZE_OF_BIGINT + SIZE_OF_WORD - 1) / SIZE_OF_WORD * SIZE_OF_WORD)
+
+/**
+ * @brief Computes the size of the block for a Bigint with at least [min_capacity] digits.
+ * 
+ * The digits are stored right after the Bigint structure in the same block, and the
+ * block is rounded up to whole cache lines. The capacity derived from a block size
+ * gives the same block size back, so bigint_block_size([bigint]->capacity) is the
+ * size of the block that was allocated for [bigint].
+ * 
+ * @param min_capacity [input] Minimum number of digits.
+ * @return size_t Size of the block in bytes.
+ */
+static size_t bigint_block_size(size_t min_capacity)
+{
+    if (min_capacity < BIGINT_INLINE_DIGIT_NUM) min_capacity = BIGINT_INLINE_DIGIT_NUM;
+
+    size_t block_size = BIGINT_HEADER_SIZE + min_capacity * SIZE_OF_WORD;
+
+    return (block_size + BIGINT_ALIGNMENT - 1) / BIGINT_ALIGNMENT * BIGINT_ALIGNMENT;
+}
+
+/**
+ * @brief Default allocation hook: memory aligned to [alignment].
+ */
+static void* default_alloc(size_t size, size_t alignment, void* context)
+{
+    (void)context;
+
+#if defined(_WIN32)
+    return _aligned_malloc(size, alignment);
+#else
+    return aligned_alloc(alignment, size);
+#endif
+}
+
+/**
+ * @brief Default free hook.
+ */
+static void default_free(void* memory, size_t size, void* context)
+{
+    (void)size;
+    (void)context;
+
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+static void* default_realloc(void* memory, size_t old_size, size_t new_size, size_t alignment, void* context);
+
+static BigintAllocFunction   allocator_alloc   = default_alloc;   ///< Hook allocating all Bigint memory.
+static BigintReallocFunction allocator_realloc = default_realloc; ///< Hook growing a Bigint block.
+static BigintFreeFunction    allocator_free    = default_free;    ///< Hook releasing all Bigint memory.
+static void*                 allocator_context = NULL;            ///< Context passed to the hooks.
+
+/**
+ * @brief Default reallocation hook.
+ * 
+ * C has no aligned realloc, so the memory is moved to a new aligned block.
+ * The block is allocated and released with the hooks in use, so that custom
+ * allocation and free hooks work without a reallocation hook.
+ */
+static void* default_realloc(void* memory, size_t old_size, size_t new_size, size_t alignment, void* context)
+{
+    void* new_memory = allocator_alloc(new_size, alignment, context);
+
+    if (new_memory == NULL) return NULL;
+
+    memcpy(new_memory, memory, (old_size < new_size) ? old_size : new_size);
+    allocator_free(memory, old_size, context);
+
+    return new_memory;
+}
+
+/**
+ * @brief Sets the functions used for all memory of the library.
+ * 
+ * Bigint blocks and the chunks of the scratch arena are allocated through these hooks,
+ * so the memory can be routed to a dedicated arena, a pool or huge pages.
+ * Passing NULL for a hook restores its default (aligned_alloc and free). The default
+ * reallocation hook moves the block with the other two hooks.
+ * 
+ * Call this before any Bigint is allocated, or after all of them are deleted and
+ * bigint_scratch_free has been called on every thread: memory is always released
+ * with the hook that is set at that time.
+ * 
+ * @param alloc_function [input] Allocation hook, or NULL.
+ * @param realloc_function [input] Reallocation hook, or NULL.
+ * @param free_function [input] Free hook, or NULL.
+ * @param context [input] Pointer passed to every hook call.
+ */
+void bigint_set_allocator(BigintAllocFunction alloc_function, BigintReallocFunction realloc_function, BigintFreeFunction free_function, void* context)
+{
+    allocator_alloc   = (alloc_function   != NULL) ? alloc_function   : default_alloc;
+    allocator_realloc = (realloc_function != NULL) ? realloc_function : default_realloc;
+    allocator_free    = (free_function    != NULL) ? free_function    : default_free;
+    allocator_context = context;
+}
+
+/**
+ * @brief Allocates memory aligned to a cache line.
+ * 
+ * @param size [input] Size in bytes (a multiple of BIGINT_ALIGNMENT).
+ * @return void* Allocated memory, or NULL if allocation fails.
+ */
+static void* memory_allocate(size_t size)
+{
+    return allocator_alloc(size, BIGINT_ALIGNMENT, allocator_context);
+}
+
+/**
+ * @brief Releases memory allocated by memory_allocate.
+ * 
+ * @param memory [input] Memory to release.
+ * @param size [input] Size in bytes given when the memory was allocated.
+ */
+static void memory_release(void* memory, size_t size)
+{
+    allocator_free(memory, size, allocator_context);
+}
+
+/**
+ * @brief Initializes a block as a Bigint with a zero value.
+ * 
+ * The digits that fit into the padding of the block are added to the capacity,
+ * so small integers (BIGINT_INLINE_DIGIT_NUM digits or fewer) always fit into
+ * the first cache line with the structure itself.
+ * 
+ * @param block [input] Block of [block_size] bytes.
+ * @param block_size [input] Size of the block in bytes.
+ * @param storage [input] Owner of the block.
+ * @return Bigint* The Bigint stored in [block].
+ */
+static Bigint* bigint_init_block(void* block, size_t block_size, Storage storage)
+{
+    Bigint* bigint = (Bigint*)block;
+
+    bigint->sign = POSITIVE;
+    bigint->storage = storage;
+    bigint->digit_num = 1;
+    bigint->capacity = (block_size - BIGINT_HEADER_SIZE) / SIZE_OF_WORD;
+    bigint->digits = (Word*)((unsigned char*)bigint + BIGINT_HEADER_SIZE); // digits follow the structure
+    bigint->digits[0] = 0;
+
+    return bigint;
+}
+
+/**
+ * @brief Allocates one cache-aligned block for a Bigint and its digits.
+ * 
+ * @param min_capacity [input] Minimum number of digits.
+ * @return Bigint* New Bigint with a zero value, or NULL if allocation fails.
+ */
+static Bigint* bigint_allocate(size_t min_capacity)
+{
+    size_t block_size = bigint_block_size(min_capacity);
+    void* block = memory_allocate(block_size);
+
+    if (block == NULL) return NULL;
+
+    return bigint_init_block(block, block_size, STORAGE_HEAP);
+}
+
+/**
+ * @brief Grows the block of a Bigint to at least [min_capacity] digits, keeping its digits.
+ * 
+ * A heap block is grown with the reallocation hook. A block of the scratch arena
+ * or a view is copied to a new heap block instead, since neither can grow in place.
+ * 
+ * @param bigint [input] Bigint to grow.
+ * @param min_capacity [input] Minimum number of digits.
+ * @return Bigint* The grown Bigint (possibly at a new address), or NULL if allocation fails.
+ */
+static Bigint* bigint_reallocate(Bigint* bigint, size_t min_capacity)
+{
+    size_t block_size = bigint_block_size(min_capacity);
+
+    if (bigint->storage != STORAGE_HEAP) {
+        Bigint* grown = bigint_allocate(min_capacity);
+        if (grown == NULL) return NULL;
+
+        grown->sign = bigint->sign;
+        grown->digit_num = bigint->digit_num;
+        memcpy(grown->digits, bigint->digits, bigint->digit_num * SIZE_OF_WORD);
+
+        return grown;
+    }
+
+    Bigint* grown = (Bigint*)allocator_realloc(bigint, bigint_block_size(bigint->capacity),
+                                               block_size, BIGINT_ALIGNMENT, allocator_context);
+    if (grown == NULL) return NULL;
+
+    grown->capacity = (block_size - BIGINT_HEADER_SIZE) / SIZE_OF_WORD;
+    grown->digits = (Word*)((unsigned char*)grown + BIGINT_HEADER_SIZE); // the block has moved
+
+    return grown;
+}
+
+/**
+ * @brief Releases the block of a Bigint if the Bigint owns it.
+ * 
+ * Blocks from the scratch arena are reclaimed by bigint_scratch_release,
+ * and a view owns no memory.
+ * 
+ * @param bigint [input] Bigint to release.
+ */
+static void bigint_release(Bigint* bigint)
+{
+    if (bigint->storage == STORAGE_HEAP)
+        memory_release(bigint, bigint_block_size(bigint->capacity));
+}
+
+/**
+ * @struct scratch_chunk
+ * @brief Chunk of the scratch arena. The usable memory follows the header.
+ */
+typedef struct ScratchChunk {
+    struct ScratchChunk* prev; ///< Previous chunk.
+    struct ScratchChunk* next; ///< Next chunk, kept for reuse after a release.
+    size_t size;               ///< Usable bytes.
+    size_t top;                ///< Offset of the first free byte.
+} ScratchChunk;
+
+#define SCRATCH_CHUNK_HEADER_SIZE ((sizeof(ScratchChunk) + BIGINT_ALIGNMENT - 1) / BIGINT_ALIGNMENT * BIGINT_ALIGNMENT)
+
+static THREAD_LOCAL ScratchChunk* scratch_first = NULL;      ///< First chunk of the arena of this thread.
+static THREAD_LOCAL ScratchChunk* scratch_current = NULL;    ///< Chunk to carve from.
+static THREAD_LOCAL size_t scratch_in_use = 0;               ///< Bytes in use.
+static THREAD_LOCAL size_t scratch_high_water = 0;           ///< Largest [scratch_in_use] so far.
+
+/**
+ * @brief Appends a chunk with at least [size] usable bytes to the arena and makes it current.
+ * 
+ * The current chunk must be the last one (see scratch_chunk_next).
+ * 
+ * @param size [input] Required usable bytes.
+ * @return ScratchChunk* New current chunk, or NULL if allocation fails.
+ */
+static ScratchChunk* scratch_chunk_append(size_t size)
+{
+    /* Chunks grow geometrically */
+    size_t chunk_size = SCRATCH_CHUNK_SIZE;
+    if (scratch_current != NULL && chunk_size < scratch_current->size * 2) chunk_size = scratch_current->size * 2;
+    if (chunk_size < size) chunk_size = size;
+
+    ScratchChunk* chunk = (ScratchChunk*)memory_allocate(SCRATCH_CHUNK_HEADER_SIZE + chunk_size);
+    if (chunk == NULL) return NULL;
+
+    chunk->prev = scratch_current;
+    chunk->next = NULL;
+    chunk->size = chunk_size;
+    chunk->top = 0;
+
+    if (scratch_current != NULL) scratch_current->next = chunk;
+    else scratch_first = chunk;
+
+    return scratch_current = chunk;
+}
+
+/**
+ * @brief Moves the arena to a chunk with at least [size] usable bytes after the current one.
+ * 
+ * The first cached chunk large enough is reused. Cached chunks too small for [size]
+ * before it are freed, and a new chunk is appended if none is large enough.
+ * 
+ * @param size [input] Required usable bytes.
+ * @return ScratchChunk* New current chunk, or NULL if allocation fails.
+ */
+static ScratchChunk* scratch_chunk_next(size_t size)
+{
+    if (scratch_current == NULL)
+        return scratch_chunk_append(size);
+
+    /* Free the cached chunks that are too small */
+    ScratchChunk* cached = scratch_current->next;
+    while (cached != NULL && cached->size < size) {
+        ScratchChunk* next = cached->next;
+        memory_release(cached, SCRATCH_CHUNK_HEADER_SIZE + cached->size);
+        cached = next;
+    }
+
+    scratch_current->next = cached;
+    if (cached == NULL)
+        return scratch_chunk_append(size);
+
+    cached->prev = scratch_current;
+    cached->top = 0;
+
+    return scratch_current = cached;
+}
+
+/**
+ * @brief Carves [size] bytes from the scratch arena of the calling thread.
+ * 
+ * @param size [input] Size in bytes (a multiple of BIGINT_ALIGNMENT).
+ * @return void* Carved memory, or NULL if allocation fails.
+ */
+static void* scratch_allocate(size_t size)
+{
+    ScratchChunk* chunk = scratch_current;
+
+    /* Current chunk is full: move to a cached chunk or append a new one */
+    if (chunk == NULL || chunk->top + size > chunk->size) 
+    {
+        chunk = scratch_chunk_next(size);
+        if (chunk == NULL) return NULL;
+    }
+
+    void* memory = (unsigned char*)chunk + SCRATCH_CHUNK_HEADER_SIZE + chunk->top;
+    chunk->top += size;
+
+    /* Capacity planning */
+    scratch_in_use += size;
+    if (scratch_high_water < scratch_in_use) scratch_high_water = scratch_in_use;
+
+    return memory;
+}
 
 /**
  * @brief Allocates memory for a large integer.
@@ -7,23 +336,55 @@
  * and stores the address in the [bigint] variable. If you want to use
  * the integer 0xFFFFFFFFFFFF in a 32-bit environment, set new_digit_num to 2.
  * 
+ * If [bigint] already has a capacity of at least [new_digit_num] digits,
+ * its memory is reused and only cleared to zero.
+ * 
  * @param bigint [output] Memory address of the large integer.
  * @param new_digit_num [input] Number of digits.
  */
-void bigint_new(Bigint** bigint, Word new_digit_num)
+void bigint_new(Bigint** bigint, size_t new_digit_num)
 {
-    /* Free allocated memory */
-    if (*bigint != NULL) 
-        bigint_delete(bigint);
-
     /* Size is at least 1 */
     if (new_digit_num == 0) new_digit_num = 1;
 
+    /* Free allocated memory if it is not large enough */
+    if (*bigint != NULL && (*bigint)->capacity < new_digit_num) 
+        bigint_delete(bigint); // A Bigint from the scratch arena grows on the heap.
+
     /* Allocate Bigint */
-    *bigint = (Bigint*)malloc(SIZE_OF_BIGINT);
+    if (*bigint == NULL)
+        *bigint = bigint_allocate(new_digit_num);
+
+    /* Initialize Bigint */
     (*bigint)->sign = POSITIVE;
     (*bigint)->digit_num = new_digit_num;
-    (*bigint)->digits = (Word*)calloc(new_digit_num, SIZE_OF_WORD);
+    memset((*bigint)->digits, 0, new_digit_num * SIZE_OF_WORD);
+}
+
+/**
+ * @brief Changes the number of digits of a large integer while keeping its value.
+ * 
+ * New upper digits are filled with zero. Memory is reallocated only if
+ * [new_digit_num] exceeds the capacity of [bigint], and then [bigint] gets a new address.
+ * We use this function to pad an operand to a fixed number of digits.
+ * 
+ * @param bigint [input/output] Memory address of the large integer.
+ * @param new_digit_num [input] New number of digits.
+ */
+void bigint_resize(Bigint** bigint, size_t new_digit_num)
+{
+    /* Size is at least 1 */
+    if (new_digit_num == 0) new_digit_num = 1;
+
+    /* Grow memory */
+    if (new_digit_num > (*bigint)->capacity)
+        *bigint = bigint_reallocate(*bigint, new_digit_num);
+
+    /* Zero-fill the new digits */
+    if (new_digit_num > (*bigint)->digit_num)
+        memset((*bigint)->digits + (*bigint)->digit_num, 0, (new_digit_num - (*bigint)->digit_num) * SIZE_OF_WORD);
+
+    (*bigint)->digit_num = new_digit_num;
 }
 
 /**
@@ -41,18 +402,131 @@ void bigint_delete(Bigint** bigint)
     if (*bigint == NULL) 
         return;
 
-    /* Free memory */
-    free((*bigint)->digits);
-    free(*bigint);
+    /* Free memory: the digits are in the same block */
+    bigint_release(*bigint);
+    *bigint = NULL;
 }
 
 /**
- * @brief Free unused memory.
+ * @brief Takes a mark of the scratch arena of the calling thread.
  * 
- * Frees unused memory in the allocated large integer memory of [bigint] 
- * if the integer stored in the memory is not large enough to utilize the upper addresses.
- * Additionally, adjusts the memory size and structure of the large integer, 
- * taking into account scenarios such as 0xFFFFFFFFFFFF in a 32-bit environment with digit_num as 3.
+ * @return ScratchMark Current position of the arena.
+ */
+ScratchMark bigint_scratch_mark(void)
+{
+    ScratchMark mark;
+
+    mark.chunk = scratch_current;
+    mark.top = (scratch_current != NULL) ? scratch_current->top : 0;
+    mark.in_use = scratch_in_use;
+
+    return mark;
+}
+
+/**
+ * @brief Releases all temporaries carved from the scratch arena after [mark].
+ * 
+ * Temporaries must be released in LIFO order: a routine releases its own mark before
+ * it returns, after calling bigint_delete on its temporaries (a temporary that grew
+ * beyond its capacity moved to the heap). The chunks are kept for reuse, so routines
+ * perform no allocation in steady state.
+ * 
+ * @param mark [input] Mark taken by bigint_scratch_mark.
+ */
+void bigint_scratch_release(ScratchMark mark)
+{
+    scratch_current = (mark.chunk != NULL) ? (ScratchChunk*)mark.chunk : scratch_first;
+    if (scratch_current != NULL) scratch_current->top = mark.top;
+
+    scratch_in_use = mark.in_use;
+}
+
+/**
+ * @brief Allocates a temporary large integer from the scratch arena.
+ * 
+ * Works like bigint_new for a NULL [bigint], but carves the memory from the scratch
+ * arena of the calling thread. Allocate temporaries with their final size: a
+ * temporary that has to grow later is moved to the heap.
+ * 
+ * @param bigint [output] Memory address of the temporary large integer.
+ * @param new_digit_num [input] Number of digits.
+ */
+void bigint_scratch_new(Bigint** bigint, size_t new_digit_num)
+{
+    /* Size is at least 1 */
+    if (new_digit_num == 0) new_digit_num = 1;
+
+    size_t block_size = bigint_block_size(new_digit_num);
+    void* block = scratch_allocate(block_size);
+
+    /* Fall back to the heap */
+    if (block == NULL) {
+        *bigint = NULL;
+        bigint_new(bigint, new_digit_num);
+        return;
+    }
+
+    *bigint = bigint_init_block(block, block_size, STORAGE_SCRATCH);
+    (*bigint)->digit_num = new_digit_num;
+    memset((*bigint)->digits, 0, new_digit_num * SIZE_OF_WORD);
+}
+
+/**
+ * @brief Makes sure the scratch arena of the calling thread has [size] free bytes in one chunk.
+ * 
+ * Call this at thread start with the high-water mark of a previous run
+ * to avoid any allocation in the arithmetic routines later.
+ * [size] is rounded up to a multiple of BIGINT_ALIGNMENT, like every block of the arena.
+ * 
+ * @param size [input] Number of bytes.
+ */
+void bigint_scratch_reserve(size_t size)
+{
+    size = (size + BIGINT_ALIGNMENT - 1) / BIGINT_ALIGNMENT * BIGINT_ALIGNMENT;
+
+    if (scratch_current != NULL && scratch_current->top + size <= scratch_current->size)
+        return;
+
+    scratch_chunk_next(size);
+}
+
+/**
+ * @brief Returns the largest number of bytes the scratch arena of the calling thread has had in use.
+ * 
+ * @return size_t High-water mark in bytes.
+ */
+size_t bigint_scratch_high_water_mark(void)
+{
+    return scratch_high_water;
+}
+
+/**
+ * @brief Frees all chunks of the scratch arena of the calling thread.
+ * 
+ * Call this before a thread exits. No temporary may be in use.
+ */
+void bigint_scratch_free(void)
+{
+    ScratchChunk* chunk = scratch_first;
+
+    while (chunk != NULL) {
+        ScratchChunk* next = chunk->next;
+        memory_release(chunk, SCRATCH_CHUNK_HEADER_SIZE + chunk->size);
+        chunk = next;
+    }
+
+    scratch_first = NULL;
+    scratch_current = NULL;
+    scratch_in_use = 0;
+}
+
+/**
+ * @brief Removes leading zero digits.
+ * 
+ * Lowers the number of digits of [bigint] if the integer stored in the memory
+ * is not large enough to utilize the upper addresses, taking into account scenarios
+ * such as 0xFFFFFFFFFFFF in a 32-bit environment with digit_num as 3.
+ * The memory is kept as capacity, so the next operation on [bigint] can reuse it.
  * 
  * @param bigint [input/output] Memory address of the large integer.
  */
@@ -62,7 +536,7 @@ void bigint_refine(Bigint* bigint)
     if (bigint == NULL) return;
 
     /* New number of digits */
-    Word new_digit_num = bigint->digit_num;
+    size_t new_digit_num = bigint->digit_num;
 
     /* Calculate the new number of digits */
     while (new_digit_num > 1) {
@@ -70,12 +544,8 @@ void bigint_refine(Bigint* bigint)
         new_digit_num--;
     }
 
-    /* Check if refinement is needed */
-    if (bigint->digit_num == new_digit_num) return;
-
-    /* Refine memory */
+    /* Refine number of digits */
     bigint->digit_num = new_digit_num;
-    bigint->digits = (Word*)realloc(bigint->digits, SIZE_OF_WORD * new_digit_num);
 
     /* Zero is always positive */
     if (bigint_is_zero(bigint)) 
@@ -102,7 +572,7 @@ void bigint_show_hex(const Bigint* bigint)
     printf(PRINT_WORD_FORMAT, bigint->digits[bigint->digit_num - 1]);
 
     /* Print the digits */
-    for (int idx = bigint->digit_num - 2; idx >= 0; idx--)
+    for (size_t idx = bigint->digit_num - 1; idx-- > 0;)
         printf(PRINT_WORD_FIX_FORMAT, bigint->digits[idx]);
 
     /* line break */
@@ -126,21 +596,21 @@ void bigint_show_hex(const Bigint* bigint)
 void bigint_set_by_hex_string(Bigint** bigint, const char* string, Sign sign)
 {
     /* Get length of string and new digit number */
-    Word length_string = (Word)strlen(string);
-    Word new_digit_num = (length_string / (SIZE_OF_WORD * 2)) + (length_string % (SIZE_OF_WORD * 2) != 0);
+    size_t length_string = strlen(string);
+    size_t new_digit_num = (length_string / (SIZE_OF_WORD * 2)) + (length_string % (SIZE_OF_WORD * 2) != 0);
 
     /* Allocate Bigint */
     bigint_new(bigint, new_digit_num);
     (*bigint)->sign = sign;
 
     /* String to Bigint */
-    for (int idx = 0; idx < new_digit_num; idx++) 
+    for (size_t idx = 0; idx < new_digit_num; idx++) 
     {
         /* Char to int */
         for (int idx_4bit = 0; idx_4bit < BITLEN_OF_WORD; idx_4bit += 4)
         {
             char char_1byte = string[--length_string];
-            Word int_4bit;
+            Word int_4bit = 0;
 
             /* One byte char to 4-bits int */
             if ('0' <= char_1byte && char_1byte <= '9') int_4bit = char_1byte - '0';
@@ -169,12 +639,16 @@ void bigint_set_by_hex_string(Bigint** bigint, const char* string, Sign sign)
  */
 void bigint_copy(Bigint** bigint_dest, const Bigint* bigint_src)
 { 
+    /* Nothing to copy */
+    if (*bigint_dest == bigint_src)
+        return;
+
     /* Allocate new Bigint */
-    Word new_digit_num = bigint_src->digit_num;
+    size_t new_digit_num = bigint_src->digit_num;
     bigint_new(bigint_dest, new_digit_num);
 
     /* Copy the digits */
-    for (int idx = 0; idx < new_digit_num; idx++)
+    for (size_t idx = 0; idx < new_digit_num; idx++)
         (*bigint_dest)->digits[idx] = bigint_src->digits[idx];
 
     /* Copy the sign */
@@ -184,15 +658,15 @@ void bigint_copy(Bigint** bigint_dest, const Bigint* bigint_src)
 /**
  * @brief Copies a part of a large integer into a new large integer.
  * 
- * We will use this function in Karatsuba multiplication to divide the operands.
  * Note that the result is always POSITIVE.
+ * Use bigint_view_part instead if the part is only read.
  * 
  * @param result [output] The new large integer.
  * @param bigint [input] The source large integer.
  * @param offset_start [input] Starting offset of digits.
  * @param offset_end [input] Ending offset of digits.
  */
-void bigint_copy_part(Bigint** result, const Bigint* bigint, Word offset_start, Word offset_end) 
+void bigint_copy_part(Bigint** result, const Bigint* bigint, size_t offset_start, size_t offset_end) 
 {
     /* Invalid offset */
 	if (bigint->digit_num < offset_end || bigint->digit_num < offset_start || offset_end < offset_start) {
@@ -202,32 +676,168 @@ void bigint_copy_part(Bigint** result, const Bigint* bigint, Word offset_start,
     }
 
     /* Allocate Bigint */
-    Word new_digit_num = offset_end - offset_start;
+    size_t new_digit_num = offset_end - offset_start;
     bigint_new(result, new_digit_num);
 
     /* copy the digits */
-    for(int i = 0; i < new_digit_num; i++)
+    for(size_t i = 0; i < new_digit_num; i++)
         (*result)->digits[i] = bigint->digits[offset_start + i];
 
     bigint_refine(*result);
 }
 
+/**
+ * @brief Swaps two large integers by exchanging their pointers.
+ * 
+ * Hands a finished buffer over to another variable without copying a digit.
+ * For example, an accumulator loop can compute into [next] and then swap
+ * [next] with [accumulator], so the two buffers are reused in turn.
+ * 
+ * @param bigint_x [input/output] Memory address of the first large integer.
+ * @param bigint_y [input/output] Memory address of the second large integer.
+ */
+void bigint_swap(Bigint** bigint_x, Bigint** bigint_y)
+{
+    Bigint* tmp = *bigint_x;
+
+    *bigint_x = *bigint_y;
+    *bigint_y = tmp;
+}
+
+/**
+ * @brief Checks if writing to [output] may change [operand].
+ * 
+ * True if they are the same large integer, or if the memory of [output]
+ * overlaps the digits of [operand] (for example, [operand] is a view of [output]).
+ * 
+ * @param output [input] Output large integer, or NULL.
+ * @param operand [input] Operand large integer, or NULL.
+ * @return char TRUE if they are aliased, otherwise FALSE.
+ */
+char bigint_is_aliased(const Bigint* output, const Bigint* operand)
+{
+    if (output == NULL || operand == NULL) return FALSE;
+    if (output == operand) return TRUE;
+
+    uintptr_t output_begin  = (uintptr_t)output->digits;
+    uintptr_t output_end    = (uintptr_t)(output->digits + output->capacity);
+    uintptr_t operand_begin = (uintptr_t)operand->digits;
+    uintptr_t operand_end   = (uintptr_t)(operand->digits + operand->digit_num);
+
+    return (output_begin < operand_end && operand_begin < output_end) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Allocates the output buffer of an operation.
+ * 
+ * If [result] is not aliased with an operand, the operation writes straight into it:
+ * [result] is allocated with [digit_num] digits (reusing its capacity) and returned.
+ * Otherwise, a temporary is carved from the scratch arena into [tmp_result] and returned,
+ * and bigint_output_finish copies it into [result] once the operands are no longer read.
+ * Call this after taking a scratch mark, and release the mark after bigint_output_finish.
+ * 
+ * @param result [input/output] Memory address of the result of the operation.
+ * @param tmp_result [output] Memory address of the temporary (must be NULL).
+ * @param digit_num [input] Number of digits of the output.
+ * @param operand_x [input] First operand, or NULL.
+ * @param operand_y [input] Second operand, or NULL.
+ * @return Bigint** The buffer to write to: [result] or [tmp_result].
+ */
+Bigint** bigint_output_new(Bigint** result, Bigint** tmp_result, size_t digit_num, const Bigint* operand_x, const Bigint* operand_y)
+{
+    if (bigint_is_aliased(*result, operand_x) || bigint_is_aliased(*result, operand_y)) {
+        bigint_scratch_new(tmp_result, digit_num);
+        return tmp_result;
+    }
+
+    bigint_new(result, digit_num);
+    return result;
+}
+
+/**
+ * @brief Hands the output buffer of an operation over to [result].
+ * 
+ * Nothing is copied if the operation wrote straight into [result].
+ * 
+ * @param result [output] Memory address of the result of the operation.
+ * @param tmp_result [input] Temporary given by bigint_output_new.
+ */
+void bigint_output_finish(Bigint** result, Bigint** tmp_result)
+{
+    if (*tmp_result == NULL)
+        return;
+
+    bigint_copy(result, *tmp_result);
+    bigint_delete(tmp_result);
+}
+
+/**
+ * @brief Creates a read-only view of an array of digits.
+ * 
+ * A view is a Bigint that does not own its digits: creating it costs nothing,
+ * and it can be passed to every function as a read-only operand (const Bigint*).
+ * Leading zero digits are not counted, like bigint_refine does.
+ * 
+ * Never pass the address of a view as an output, and never use a view after
+ * the digits it refers to are modified or released.
+ * 
+ * @param digits [input] Digits of the view (least significant word first).
+ * @param digit_num [input] Number of digits (0 gives a view of zero).
+ * @param sign [input] Sign of the view.
+ * @return Bigint The view.
+ */
+Bigint bigint_view(const Word* digits, size_t digit_num, Sign sign)
+{
+    static const Word zero_digit = 0;
+    Bigint view;
+
+    /* Empty view is zero */
+    if (digit_num == 0) {
+        digits = &zero_digit;
+        digit_num = 1;
+    }
+
+    digit_num = word_array_refined_length(digits, digit_num);
+
+    view.sign = (digit_num == 1 && digits[0] == 0) ? POSITIVE : sign;
+    view.storage = STORAGE_VIEW;
+    view.digit_num = digit_num;
+    view.capacity = 0; // A view never has room for writes.
+    view.digits = (Word*)digits;
+
+    return view;
+}
+
+/**
+ * @brief Creates a read-only view of a part of a large integer.
+ * 
+ * The zero-copy version of bigint_copy_part: the view refers to the digits
+ * from [offset_start] to [offset_end] of [bigint] and is always POSITIVE.
+ * Offsets beyond the number of digits are treated as leading zero digits,
+ * so the view of a part above the most significant digit is zero.
+ * For example, the view from [wordlen] to the end is [bigint] >> W^[wordlen].
+ * 
+ * @param bigint [input] The source large integer.
+ * @param offset_start [input] Starting offset of digits.
+ * @param offset_end [input] Ending offset of digits.
+ * @return Bigint The view.
+ */
+Bigint bigint_view_part(const Bigint* bigint, size_t offset_start, size_t offset_end)
+{
+    if (offset_end > bigint->digit_num) offset_end = bigint->digit_num;
+    if (offset_start > offset_end) offset_start = offset_end;
+
+    return bigint_view(bigint->digits + offset_start, offset_end - offset_start, POSITIVE);
+}
+
 char bigint_compare_abs(const Bigint* operand_x, const Bigint* operand_y)
 {
     //Return 1 if operand_x's dmax is bigger than operand_y's dmax
     if (operand_x->digit_num > operand_y->digit_num) return 1;
     if (operand_x->digit_num < operand_y->digit_num) return -1;
 
-    //if operand_x->digit_num == y_dmax, compare each digit
-    for (int idx = operand_x->digit_num - 1; idx >= 0; idx--) 
-    {
-        //Return 1 if the value of the digit in operand_x is bigger than the value of the digit in operand_y
-        if (operand_x->digits[idx] > operand_y->digits[idx]) return 1;
-        if (operand_x->digits[idx] < operand_y->digits[idx]) return -1;
-    }
-
-    //if all the digits are the same, return 0
-    return 0;
+    //if operand_x->digit_num == y_dmax, compare each digit from the top
+    return (char)word_array_compare(operand_x->digits, operand_y->digits, operand_x->digit_num);
 }
 
 /**
@@ -275,7 +885,7 @@ char bigint_compare(const Bigint* operand_x, const Bigint* operand_y)
  * @param sign [input] Sign of the large integer.
  * @param digit_num [input] Number of digits for the large integer.
  */
-void bigint_generate_random_number(Bigint** bigint, Sign sign, Word digit_num)
+void bigint_generate_random_number(Bigint** bigint, Sign sign, size_t digit_num)
 {
     /* Allocate Bigint */
     bigint_new(bigint, digit_num);
@@ -283,11 +893,11 @@ void bigint_generate_random_number(Bigint** bigint, Sign sign, Word digit_num)
 
     /* Variables for generating a random number */
     uint8_t* byte_rand_num = (uint8_t*)(*bigint)->digits; // pointer about bigint.
-    int count = digit_num * SIZE_OF_WORD;                 // bytelen of bigint.
+    size_t count = digit_num * SIZE_OF_WORD;              // bytelen of bigint.
 
     /* 8-bit random number generator */
     while (count--)
-        *byte_rand_num++ = (Word)rand() & MASK8BIT;
+        *byte_rand_num++ = (uint8_t)(rand() & MASK8BIT);
 
     /* Free unuse memory */
     bigint_refine(*bigint);
@@ -329,7 +939,7 @@ void bigint_set_one(Bigint** bigint)
  * @param bigint [input] The source large integer.
  * @param wordlen [input] Words to add for expansion.
  */
-void bigint_expand(Bigint** result, const Bigint* bigint, Word wordlen) 
+void bigint_expand(Bigint** result, const Bigint* bigint, size_t wordlen) 
 {
     /* No need to expand */
     if (wordlen == 0) {
@@ -337,22 +947,23 @@ void bigint_expand(Bigint** result, const Bigint* bigint, Word wordlen)
         return;
     }
 
-    Bigint* tmp_result = NULL;
-    Word count = bigint->digit_num;
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with an operand.
+    size_t count = bigint->digit_num;
 
     /* Allocate Bigint */
-    bigint_new(&tmp_result, bigint->digit_num + wordlen);
+    Bigint** output = bigint_output_new(result, &tmp_result, bigint->digit_num + wordlen, bigint, NULL);
 
     /* Expand(left shift) wordlen index */
     while(count--)
-        tmp_result->digits[count + wordlen] = bigint->digits[count];
+        (*output)->digits[count + wordlen] = bigint->digits[count];
 
     /* Get Result */
-    bigint_refine(tmp_result);
-    bigint_copy(result, tmp_result);
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
 
     /* Free Bigint */
-    bigint_delete(&tmp_result);
+    bigint_scratch_release(mark);
 }
 
 /**
@@ -365,7 +976,7 @@ void bigint_expand(Bigint** result, const Bigint* bigint, Word wordlen)
  * @param bigint [input] The source large integer.
  * @param wordlen [input] Number of leading words to remove.
  */
-void bigint_compress(Bigint** result, const Bigint* bigint, Word wordlen) 
+void bigint_compress(Bigint** result, const Bigint* bigint, size_t wordlen) 
 {
     /* Over compress */
     if (bigint->digit_num <= wordlen) {
@@ -379,35 +990,36 @@ void bigint_compress(Bigint** result, const Bigint* bigint, Word wordlen)
         return;
     }
 
-    Bigint* tmp_result = NULL;
-    Word count = bigint->digit_num - wordlen;
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with an operand.
+    size_t count = bigint->digit_num - wordlen;
 
     /* Allocate Bigint */
-    bigint_new(&tmp_result, bigint->digit_num);
+    Bigint** output = bigint_output_new(result, &tmp_result, bigint->digit_num, bigint, NULL);
 
     /* Compress(shift right) wordlen index */
     while(count--)
-        tmp_result->digits[count] = bigint->digits[count + wordlen];
+        (*output)->digits[count] = bigint->digits[count + wordlen];
 
     /* Get result */
-    bigint_refine(tmp_result);
-    bigint_copy(result, tmp_result);
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
 
     /* Free Bigint */
-    bigint_delete(&tmp_result);
+    bigint_scratch_release(mark);
 }
 
 /* get bit length of bigint */
-Word bigint_get_bit_length(const Bigint* bigint)
+size_t bigint_get_bit_length(const Bigint* bigint)
 {
     return bigint->digit_num * BITLEN_OF_WORD;
 }
 
 /* get digits bit located in the bit_idx of an bigint */
-Word bigint_get_bit(const Bigint* bigint, Word bit_idx)
+Word bigint_get_bit(const Bigint* bigint, size_t bit_idx)
 {
-    Word digit_idx = bit_idx / BITLEN_OF_WORD;
-    Word bit_idx_in_one_digit = bit_idx % BITLEN_OF_WORD;
+    size_t digit_idx = bit_idx / BITLEN_OF_WORD;
+    size_t bit_idx_in_one_digit = bit_idx % BITLEN_OF_WORD;
 
     /* is bit 1? or 0? */
     Word bit = (bigint->digits[digit_idx] >> bit_idx_in_one_digit) & MASK1BIT; 
@@ -417,36 +1029,85 @@ Word bigint_get_bit(const Bigint* bigint, Word bit_idx)
 
 void bigint_expand_one_bit(Bigint** result, const Bigint* bigint)
 {
-    Word carry = 0;
-    Bigint* tmp_result = NULL;
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with an operand.
 
-    bigint_new(&tmp_result, bigint->digit_num + 1);
+    Bigint** output = bigint_output_new(result, &tmp_result, bigint->digit_num + 1, bigint, NULL);
 
-    for (int idx = 0; idx < bigint->digit_num; idx++) {
-        tmp_result->digits[idx] = (bigint->digits[idx] << 1) + carry;
-        carry = bigint->digits[idx] >> (BITLEN_OF_WORD - 1);
-    }
+    (*output)->digits[bigint->digit_num] = word_array_shift_left((*output)->digits, bigint->digits, bigint->digit_num, 1);
 
-    tmp_result->digits[bigint->digit_num] = carry;
-
-    bigint_refine(tmp_result);
-    bigint_copy(result, tmp_result);
-    bigint_delete(&tmp_result);
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
+    bigint_scratch_release(mark);
 }
 
 void bigint_compress_one_bit(Bigint** result, const Bigint* bigint)
 {
-    Word carry = 0;
-    Bigint* tmp_result = NULL;
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with an operand.
+
+    Bigint** output = bigint_output_new(result, &tmp_result, bigint->digit_num, bigint, NULL);
 
-    bigint_new(&tmp_result, bigint->digit_num);
+    word_array_shift_right((*output)->digits, bigint->digits, bigint->digit_num, 1);
 
-    for (int idx = bigint->digit_num - 1; idx >= 0; idx--) {
-        tmp_result->digits[idx] = (bigint->digits[idx] >> 1) + carry;
-        carry = (bigint->digits[idx] & MASK1BIT) << (BITLEN_OF_WORD - 1);
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Shifts a large integer to the left in place.
+ * 
+ * [bigint] <- [bigint] * 2^[bit_count]. [bigint] grows only if its capacity is not large enough.
+ * 
+ * @param bigint [input/output] Memory address of the large integer to update.
+ * @param bit_count [input] Number of bits to shift.
+ */
+void bigint_shift_left_inplace(Bigint** bigint, size_t bit_count)
+{
+    size_t word_count = bit_count / BITLEN_OF_WORD;
+    size_t digit_num = (*bigint)->digit_num;
+
+    bigint_resize(bigint, digit_num + word_count + 1);
+
+    /* Shift bits, then move whole words up */
+    Word* digits = (*bigint)->digits;
+    digits[digit_num] = word_array_shift_left(digits, digits, digit_num, (unsigned int)(bit_count % BITLEN_OF_WORD));
+
+    if (word_count > 0) {
+        memmove(digits + word_count, digits, (digit_num + 1) * SIZE_OF_WORD);
+        memset(digits, 0, word_count * SIZE_OF_WORD);
+    }
+
+    bigint_refine(*bigint);
+}
+
+/**
+ * @brief Shifts a large integer to the right in place.
+ * 
+ * |bigint| <- |bigint| / 2^[bit_count]. The absolute value is shifted like bigint_compress,
+ * and the memory of [bigint] is kept as capacity.
+ * 
+ * @param bigint [input/output] Memory address of the large integer to update.
+ * @param bit_count [input] Number of bits to shift.
+ */
+void bigint_shift_right_inplace(Bigint** bigint, size_t bit_count)
+{
+    size_t word_count = bit_count / BITLEN_OF_WORD;
+
+    /* Over shift */
+    if ((*bigint)->digit_num <= word_count) {
+        bigint_set_zero(bigint);
+        return;
     }
 
-    bigint_refine(tmp_result);
-    bigint_copy(result, tmp_result);
-    bigint_delete(&tmp_result);
+    /* Move whole words down, then shift bits */
+    Word* digits = (*bigint)->digits;
+    size_t digit_num = (*bigint)->digit_num - word_count;
+
+    memmove(digits, digits + word_count, digit_num * SIZE_OF_WORD);
+    word_array_shift_right(digits, digits, digit_num, (unsigned int)(bit_count % BITLEN_OF_WORD));
+
+    (*bigint)->digit_num = digit_num;
+    bigint_refine(*bigint);
 }
\ No newline at end of file
@@ -24,31 +24,54 @@
 #define AUTOBAHN_COMMON_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <assert.h>
 
 
+// Use 64-bit words on 64-bit targets unless the word size is given by BI_WORD8, BI_WORD32 or BI_WORD64
+#if !defined(BI_WORD8) && !defined(BI_WORD32) && !defined(BI_WORD64)
+    #if UINTPTR_MAX == UINT64_MAX
+        #define BI_WORD64
+    #else
+        #define BI_WORD32
+    #endif
+#endif
+
 // Define the word size based on preprocessor macros
 #if defined(BI_WORD8)
-    typedef uint8_t Word;  ///< Unsigned 16-bit word for big integers.
-    #define PRINT_WORD_FORMAT "%x"
-    #define PRINT_WORD_FIX_FORMAT "%02x"
+    typedef uint8_t Word;  ///< Unsigned 8-bit word for big integers.
+    typedef uint16_t DoubleWord; ///< Unsigned word holding the product of two words.
+    #define DOUBLE_WORD_AVAILABLE
+    #define PRINT_WORD_FORMAT "%" PRIx8
+    #define PRINT_WORD_FIX_FORMAT "%02" PRIx8
 #elif defined(BI_WORD64)
-    typedef uint64_t Word; ///< Unsigned 32-bit word for big integers.
-    #define PRINT_WORD_FORMAT "%llx"
-    #define PRINT_WORD_FIX_FORMAT "%16llx"
+    typedef uint64_t Word; ///< Unsigned 64-bit word for big integers.
+    #if defined(__SIZEOF_INT128__)
+        typedef unsigned __int128 DoubleWord; ///< Unsigned word holding the product of two words.
+        #define DOUBLE_WORD_AVAILABLE
+    #endif
+    #define PRINT_WORD_FORMAT "%" PRIx64
+    #define PRINT_WORD_FIX_FORMAT "%016" PRIx64
 #else
-    typedef uint32_t Word;  ///< Unsigned 64-bit word for big integers.
-    #define PRINT_WORD_FORMAT "%x"
-    #define PRINT_WORD_FIX_FORMAT "%08x"
+    typedef uint32_t Word;  ///< Unsigned 32-bit word for big integers.
+    typedef uint64_t DoubleWord; ///< Unsigned word holding the product of two words.
+    #define DOUBLE_WORD_AVAILABLE
+    #define PRINT_WORD_FORMAT "%" PRIx32
+    #define PRINT_WORD_FIX_FORMAT "%08" PRIx32
 #endif
 
 #define SIZE_OF_WORD sizeof(Word)
 #define SIZE_OF_BIGINT sizeof(Bigint)
 #define BITLEN_OF_WORD (sizeof(Word) * 8)
+#define BIGINT_ALIGNMENT 64       ///< Bigint blocks are aligned to a cache line.
+#define BIGINT_INLINE_DIGIT_NUM 4 ///< Minimum capacity: small integers never need a larger block.
+#define SCRATCH_CHUNK_SIZE (64 * 1024) ///< Minimum size of a chunk of the scratch arena in bytes.
 #define MASK1BIT 0x01
 #define MASK8BIT 0xFF
 #define SAME 0
@@ -69,33 +92,99 @@ typedef enum {
     NEGATIVE = 1   ///< Represents a negative value.
 } Sign;
 
+/**
+ * @enum storage
+ * @brief Enumeration representing where the memory of a Bigint comes from.
+ */
+typedef enum {
+    STORAGE_HEAP = 0,    ///< Owned block from the allocator, released by bigint_delete.
+    STORAGE_SCRATCH = 1, ///< Block carved from the scratch arena, released by bigint_scratch_release.
+    STORAGE_VIEW = 2     ///< Read-only view of digits owned by another Bigint (see bigint_view).
+} Storage;
+
 /**
  * @struct bigint
  * @brief Custom Big Integer (bigint) structure.
  *
  * @details This structure represents a custom big integer type with sign information,
- * maximum number of digits (Word), and an array to store the digits.
+ * number of digits (Word), and an array to store the digits.
+ * The number of digits is a size_t, so it does not depend on the word size.
+ * The array may be larger than the number of digits in use: [capacity] is the number
+ * of allocated digits, so shrinking a big integer never reallocates it.
+ *
+ * A Bigint and its digits share one cache-aligned allocation: [digits] points right
+ * after the structure. At least BIGINT_INLINE_DIGIT_NUM digits always fit into the
+ * first cache line, so small integers take a single allocation and a single cache line.
  */
 typedef struct {
-    Sign sign;       ///< Sign of the big integer (positive or negative).
-    Word digit_num;  ///< Maximum number of digits in the big integer.
-    Word* digits;    ///< Array to store the digits of the big integer.
+    Sign sign;        ///< Sign of the big integer (positive or negative).
+    Storage storage;  ///< Owner of the memory of the big integer.
+    size_t digit_num; ///< Number of digits in use.
+    size_t capacity;  ///< Number of allocated digits (capacity >= digit_num).
+    Word* digits;     ///< Array to store the digits of the big integer.
 } Bigint;
 
-void bigint_new(Bigint** bigint, Word new_digit_num);
+/**
+ * @brief Allocation hooks for all Bigint memory (see bigint_set_allocator).
+ *
+ * Every hook gets the [context] pointer given to bigint_set_allocator. Sizes are in bytes,
+ * and the returned memory must be aligned to [alignment] (BIGINT_ALIGNMENT).
+ * A hook returns NULL if allocation fails.
+ */
+typedef void* (*BigintAllocFunction)(size_t size, size_t alignment, void* context);
+typedef void* (*BigintReallocFunction)(void* memory, size_t old_size, size_t new_size, size_t alignment, void* context);
+typedef void  (*BigintFreeFunction)(void* memory, size_t size, void* context);
+
+/**
+ * @brief Crossover points of bigint_multiplication, bigint_squaring and bigint_division in digits (see bigint_set_thresholds).
+ *
+ * Each algorithm is used from its threshold up, unless the threshold of a faster one is reached.
+ * For multiplication, the length of the shorter operand is compared.
+ * For division, the lengths of the divisor and the quotient are compared.
+ */
+typedef struct {
+    size_t comba;              ///< Comba instead of textbook.
+    size_t karatsuba;          ///< Karatsuba.
+    size_t toom3;              ///< Toom-Cook with 5 points.
+    size_t toom4;              ///< Toom-Cook with 7 points.
+    size_t ntt;                ///< Number-theoretic transform.
+    size_t unbalanced_ratio;   ///< Ratio of lengths from which the longer operand is split into chunks.
+    size_t squaring_karatsuba; ///< Karatsuba squaring.
+    size_t squaring_toom3;     ///< Toom-Cook squaring with 5 points.
+    size_t squaring_toom4;     ///< Toom-Cook squaring with 7 points.
+    size_t squaring_ntt;       ///< NTT squaring.
+    size_t burnikel_ziegler;   ///< Burnikel-Ziegler division instead of Algorithm D.
+    size_t newton;             ///< Division by the reciprocal computed by Newton iteration.
+} Thresholds;
+
+/**
+ * @struct scratch_mark
+ * @brief Position in the scratch arena of the calling thread.
+ *
+ * @details Arithmetic routines take a mark when they start, carve their temporaries
+ * with bigint_scratch_new, and release everything above the mark when they return.
+ */
+typedef struct {
+    void* chunk;   ///< Chunk in use when the mark was taken.
+    size_t top;    ///< Offset of the first free byte in [chunk].
+    size_t in_use; ///< Total number of bytes in use when the mark was taken.
+} ScratchMark;
+
+void bigint_new(Bigint** bigint, size_t new_digit_num);
 void bigint_delete(Bigint** bigint);
 void bigint_refine(Bigint* bigint);
+void bigint_resize(Bigint** bigint, size_t new_digit_num);
 void bigint_set_by_hex_string(Bigint** bigint, const char* string, Sign sign);
 void bigint_copy(Bigint** bigint_dest, const Bigint* bigint_src);
-void bigint_generate_random_number(Bigint** bigint, Sign sign, Word digit_num);
+void bigint_generate_random_number(Bigint** bigint, Sign sign, size_t digit_num);
 void bigint_show_hex(const Bigint* bigint);
 char bigint_compare(const Bigint* operand_x, const Bigint* operand_y);
 char bigint_compare_abs(const Bigint* operand_x, const Bigint* operand_y);
-void bigint_expand(Bigint** result, const Bigint* bigint, Word wordlen);
-void bigint_compress(Bigint** result, const Bigint* bigint, Word wordlen);
-void bigint_copy_part(Bigint** result, const Bigint* bigint, Word offset_start, Word offset_end);
-Word bigint_get_bit_length(const Bigint* bigint);
-Word bigint_get_bit(const Bigint* bigint, Word bit_idx);
+void bigint_expand(Bigint** result, const Bigint* bigint, size_t wordlen);
+void bigint_compress(Bigint** result, const Bigint* bigint, size_t wordlen);
+void bigint_copy_part(Bigint** result, const Bigint* bigint, size_t offset_start, size_t offset_end);
+size_t bigint_get_bit_length(const Bigint* bigint);
+Word bigint_get_bit(const Bigint* bigint, size_t bit_idx);
 void bigint_expand_one_bit(Bigint** result, const Bigint* bigint);
 void bigint_compress_one_bit(Bigint** result, const Bigint* bigint);
 void bigint_set_zero(Bigint** bigint);
@@ -103,4 +192,29 @@ void bigint_set_one(Bigint** bigint);
 char bigint_is_zero(const Bigint* bigint);
 char bigint_is_one(const Bigint* bigint);
 
+/* In-place shifts */
+void bigint_shift_left_inplace(Bigint** bigint, size_t bit_count);
+void bigint_shift_right_inplace(Bigint** bigint, size_t bit_count);
+
+/* Result handoff */
+void bigint_swap(Bigint** bigint_x, Bigint** bigint_y);
+char bigint_is_aliased(const Bigint* output, const Bigint* operand);
+Bigint** bigint_output_new(Bigint** result, Bigint** tmp_result, size_t digit_num, const Bigint* operand_x, const Bigint* operand_y);
+void bigint_output_finish(Bigint** result, Bigint** tmp_result);
+
+/* Zero-copy views */
+Bigint bigint_view(const Word* digits, size_t digit_num, Sign sign);
+Bigint bigint_view_part(const Bigint* bigint, size_t offset_start, size_t offset_end);
+
+/* Memory management */
+void bigint_set_allocator(BigintAllocFunction alloc_function, BigintReallocFunction realloc_function, BigintFreeFunction free_function, void* context);
+
+/* Scratch arena for temporaries */
+ScratchMark bigint_scratch_mark(void);
+void bigint_scratch_release(ScratchMark mark);
+void bigint_scratch_new(Bigint** bigint, size_t new_digit_num);
+void bigint_scratch_reserve(size_t size);
+size_t bigint_scratch_high_water_mark(void);
+void bigint_scratch_free(void);
+
 #endif
@@ -1,7 +1,7 @@
 #include "autobahn.h"
+#include "autobahn_kernel.h"
 
 #define GET_MSB(word) ((word) >> (BITLEN_OF_WORD - 1))
-#define GET_BIT(word, bit_idx) ((word) >> (bit_idx)) & 1
 
 /**
  * @brief Checks for invalid or special cases of division.
@@ -40,15 +40,15 @@ static bool bigint_division_special_case(Bigint **quotient, Bigint **remainder,
     /* Special case : dividend < divisor, we have zero quotient and dividend remainder */
     if (bigint_compare(dividend, divisor) == LEFT_IS_SMALL)
     {
+        bigint_copy(remainder, dividend); // before [quotient] is cleared, it may be the dividend
         bigint_set_zero(quotient);
-        bigint_copy(remainder, dividend);
         return true;
     }
 
     /* Special case : divisor is one, we have zero remainder and dividend quotient */
     if (bigint_is_one(divisor) == TRUE)
     {
-        bigint_copy(quotient, dividend);
+        bigint_copy(quotient, dividend); // before [remainder] is cleared, it may be the dividend
         bigint_set_zero(remainder);
         return true;
     }
@@ -77,23 +77,24 @@ void bigint_division_binary_long(Bigint **quotient, Bigint **remainder, const Bi
         return;
 
     /* Number of digits about quotient and remainder */
-    Word size_quotient = dividend->digit_num - divisor->digit_num + 1;
-    Word size_remainder = divisor->digit_num;
+    size_t size_quotient = dividend->digit_num - divisor->digit_num + 1;
+    size_t size_remainder = divisor->digit_num;
 
     /* Allocate Bigint */
     Bigint *tmp_quotient = NULL;  // result of quotient
     Bigint *tmp_remainder = NULL; // result of remainder
     Bigint *two_power = NULL;  // 2^i, we will use this for get quotient
-    bigint_new(&tmp_quotient, size_quotient);
-    bigint_new(&tmp_remainder, size_remainder);
-    bigint_new(&two_power, size_quotient);
+    ScratchMark mark = bigint_scratch_mark();
+    bigint_scratch_new(&tmp_quotient, size_quotient);
+    bigint_scratch_new(&tmp_remainder, size_remainder + 1);
+    bigint_scratch_new(&two_power, size_quotient);
 
     /* Initialize Bigint */
     bigint_set_zero(&tmp_quotient);
     bigint_set_zero(&tmp_remainder);
 
     /* iteration count */
-    Word dividend_bit_len = bigint_get_bit_length(dividend);
+    size_t dividend_bit_len = bigint_get_bit_length(dividend);
 
     /* Binary long division */
     while (dividend_bit_len--)
@@ -106,7 +107,7 @@ void bigint_division_binary_long(Bigint **quotient, Bigint **remainder, const Bi
 
         bigint_set_one(&two_power); // init to compute 2^i
 
-        for (int i = 0; i < dividend_bit_len; i++)
+        for (size_t i = 0; i < dividend_bit_len; i++)
             bigint_expand_one_bit(&two_power, two_power); // 2^i
 
         bigint_addition(&tmp_quotient, tmp_quotient, two_power); // Q <- Q + 2^i
@@ -123,6 +124,7 @@ void bigint_division_binary_long(Bigint **quotient, Bigint **remainder, const Bi
     bigint_delete(&tmp_quotient);
     bigint_delete(&tmp_remainder);
     bigint_delete(&two_power);
+    bigint_scratch_release(mark);
 }
 
 /**
@@ -147,16 +149,16 @@ void bigint_division_naive(Bigint **quotient, Bigint **remainder, const Bigint *
         return;
 
     /* Number of digits about quotient and remainder */
-    Word size_quotient = dividend->digit_num - divisor->digit_num + 1;
-    Word size_remainder = divisor->digit_num;
+    size_t size_quotient = dividend->digit_num - divisor->digit_num + 1;
 
     /* Allocate Bigint */
     Bigint *tmp_quotient = NULL;  // result of quotient
     Bigint *tmp_remainder = NULL; // result of remainder
     Bigint *one = NULL;           // 1
-    bigint_new(&tmp_quotient, size_quotient);
-    bigint_new(&tmp_remainder, size_remainder);
-    bigint_new(&one, 1);
+    ScratchMark mark = bigint_scratch_mark();
+    bigint_scratch_new(&tmp_quotient, size_quotient);
+    bigint_scratch_new(&tmp_remainder, dividend->digit_num);
+    bigint_scratch_new(&one, 1);
 
     /* Initialize Bigint */
     bigint_set_zero(&tmp_quotient);
@@ -180,267 +182,633 @@ void bigint_division_naive(Bigint **quotient, Bigint **remainder, const Bigint *
     bigint_delete(&tmp_quotient);
     bigint_delete(&tmp_remainder);
     bigint_delete(&one);
+    bigint_scratch_release(mark);
 }
 
-/*
-2-word long division
-Input: A = A_1W + A_0, B
-(A_1, A_0 ∈ [0, W), B ∈ [2^w−1, 2^w), A_1 < B, A0 = a_0 + a_1*2^1 + ... + a_w-1*2^w-1)
-Output: Q such that A = BQ + R (0 ≤ R < B, Q_j ∈ [0, W)).
-1: (Q, R) ← (0, A_1)
-2: for j = w − 1 downto 0 do
-3:  if R ≥ 2^w−1 then
-4:      (Q, R) ← (Q + 2^j, 2R + a_j − B). 2R + a_j − B = R + a_j − (B − R) < W
-5:  else
-6:      R ← 2R + a_j. R ∈ [0, W)
-7:      if R ≥ B then
-8:          (Q, R) ← (Q + 2^j, R − B)
-9:      end if
-10: end if
-11: end for
-12: return Q
-*/
-static Word division_two_word(Word dividend_high, Word dividend_low, Word divisor)
+/**
+ * @brief Divides normalized word arrays with Knuth's Algorithm D.
+ *
+ * Each quotient word is estimated from the top two words of the partial remainder and
+ * the top word of [divisor] (with its reciprocal, computed once), and refined with the
+ * next words of both, so the estimate is at most one too large. The estimate times
+ * [divisor] is then subtracted from the partial remainder in place, and [divisor] is
+ * added back once if the result is negative.
+ *
+ * The most significant bit of [divisor] must be set, and the top [length_d] words of
+ * [remainder] must be less than [divisor], so every quotient word fits in a word.
+ *
+ * @param quotient [output] [length_r] - [length_d] words of the quotient.
+ * @param remainder [input/output] [length_r] words of the dividend; [length_d] words of the remainder on return.
+ * @param length_r [input] Number of words of [remainder] (greater than [length_d]).
+ * @param divisor [input] Normalized divisor.
+ * @param length_d [input] Number of words of [divisor] (at least 1).
+ */
+static void division_knuth(Word *quotient, Word *remainder, size_t length_r, const Word *divisor, size_t length_d)
 {
-    /* 파라메터 조건에 부합하는지 if문 넣기 */
-
-    Word quotient = 0;
-    Word remainder = dividend_high;
+    Word divisor_high = divisor[length_d - 1];
+    Word divisor_next = (length_d > 1) ? divisor[length_d - 2] : 0;
+    Word reciprocal = word_reciprocal(divisor_high);
 
-    for (int bit_idx = BITLEN_OF_WORD - 1; bit_idx >= 0; bit_idx--)
+    for (size_t idx = length_r - length_d; idx-- > 0;)
     {
-        Word bit_dividend_low = GET_BIT(dividend_low, bit_idx); // GET_BIT: bit_idx 번째 비트 추출
-        Word bit_expanded = 1 << bit_idx;
-
-        if (GET_MSB(remainder) == 1)
-        { // GET_MSB: remainder 의 최상위 비트 추출
-            quotient += bit_expanded;
-            remainder = remainder * 2 + bit_dividend_low - divisor;
+        Word *window = remainder + idx; // length_d + 1 words of the partial remainder
+        Word window_high = window[length_d];
+        Word window_next = window[length_d - 1];
+        Word digit;           // estimated quotient word
+        Word digit_remainder; // window_high*W + window_next - digit*divisor_high
+        bool overflow;        // digit_remainder does not fit in a word
+
+        /* window_high <= divisor_high, and equality means the quotient word is W - 1 or W - 2 */
+        if (window_high == divisor_high) {
+            digit = (Word)-1;
+            digit_remainder = window_next + divisor_high;
+            overflow = (digit_remainder < divisor_high);
+        } else {
+            digit = word_division_double_preinv(&digit_remainder, window_high, window_next, divisor_high, reciprocal);
+            overflow = false;
         }
-        else
-        {
-            remainder = remainder * 2 + bit_dividend_low;
 
-            if (remainder >= divisor)
+        /* Decrease the estimate while digit*divisor_next > digit_remainder*W + third word */
+        if (length_d > 1) {
+            Word window_third = window[length_d - 2];
+
+            while (overflow == false)
             {
-                quotient += bit_expanded;
-                remainder = remainder - divisor;
+                Word product_high, product_low;
+                word_multiplication_double(&product_high, &product_low, digit, divisor_next);
+
+                if (product_high < digit_remainder || (product_high == digit_remainder && product_low <= window_third))
+                    break;
+
+                digit--;
+                digit_remainder += divisor_high;
+                overflow = (digit_remainder < divisor_high);
             }
         }
+
+        /* Partial remainder -= digit * divisor, add back if it is negative */
+        Word borrow = word_array_submul_1(window, divisor, length_d, digit);
+        window[length_d] = window_high - borrow;
+
+        if (window_high < borrow) {
+            digit--;
+            window[length_d] += word_array_add_n(window, window, divisor, length_d);
+        }
+
+        quotient[idx] = digit;
     }
+}
 
-    return quotient;
+/**
+ * @brief Divides normalized word arrays with Algorithm D, also when the quotient has one more bit.
+ *
+ * @param quotient [output] [length_r] - [length_d] words of the quotient without its top bit.
+ * @param remainder [input/output] [length_r] words of the dividend; [length_d] words of the remainder on return.
+ * @param length_r [input] Number of words of [remainder] (greater than [length_d]).
+ * @param divisor [input] Normalized divisor.
+ * @param length_d [input] Number of words of [divisor].
+ * @return Word Top bit of the quotient: 1 if the top [length_d] words of [remainder] were not less than [divisor].
+ */
+static Word division_schoolbook(Word *quotient, Word *remainder, size_t length_r, const Word *divisor, size_t length_d)
+{
+    Word *remainder_high = remainder + length_r - length_d;
+    Word quotient_high = 0;
+
+    if (word_array_compare(remainder_high, divisor, length_d) != LEFT_IS_SMALL) {
+        word_array_sub_n(remainder_high, remainder_high, divisor, length_d);
+        quotient_high = 1;
+    }
+
+    division_knuth(quotient, remainder, length_r, divisor, length_d);
+    return quotient_high;
 }
 
-static void multiplication_bigint_and_word(Bigint **result, const Bigint *bigint, const Word word)
+static Word division_recursive(Word *quotient, Word *remainder, const Word *divisor, size_t length, size_t threshold, Bigint **product);
+
+/**
+ * @brief Computes [count] quotient words of ([length] + [count] words) / ([length] words) by recursion.
+ *
+ * The top 2*[count] words of [remainder] are divided by the top [count] words of [divisor]
+ * with division_recursive. Then the quotient times the low words of [divisor] is subtracted,
+ * and [divisor] is added back while the partial remainder is negative (a few times at most).
+ *
+ * @param quotient [output] [count] words of the quotient without its top bit.
+ * @param remainder [input/output] [length] + [count] words of the dividend; [length] words of the remainder on return.
+ * @param divisor [input] Normalized divisor.
+ * @param length [input] Number of words of [divisor].
+ * @param count [input] Number of words of [quotient] (1 <= count <= length).
+ * @param threshold [input] Lengths of divisors below this are divided by division_schoolbook.
+ * @param product [input] Temporary Bigint for the products.
+ * @return Word Top bit of the quotient.
+ */
+static Word division_recursive_top(Word *quotient, Word *remainder, const Word *divisor, size_t length, size_t count,
+                                   size_t threshold, Bigint **product)
 {
-    Bigint *word_to_bigint = NULL;
+    size_t length_low = length - count;
+    Word quotient_high = division_recursive(quotient, remainder + length_low, divisor + length_low, count, threshold, product);
 
-    /* Allocate Bigint */
-    bigint_new(&word_to_bigint, 1);
+    if (length_low == 0)
+        return quotient_high;
 
-    /* word to bigint for compatible */
-    word_to_bigint->digits[0] = word;
+    /* Subtract quotient * the low words of the divisor */
+    Bigint quotient_view = bigint_view(quotient, count, POSITIVE);
+    Bigint divisor_view = bigint_view(divisor, length_low, POSITIVE);
+    bigint_multiplication(product, &quotient_view, &divisor_view);
 
-    /* multiplication between bigint and word */
-    bigint_multiplication_textbook(result, bigint, word_to_bigint);
+    Word borrow = word_array_sub(remainder, remainder, length, (*product)->digits, (*product)->digit_num);
+    if (quotient_high != 0)
+        borrow += word_array_sub_n(remainder + count, remainder + count, divisor, length_low);
 
-    /* Free Bigint */
-    bigint_delete(&word_to_bigint);
+    /* The quotient was too large: add back */
+    while (borrow != 0)
+    {
+        quotient_high -= word_array_sub_1(quotient, quotient, count, 1);
+        borrow -= word_array_add_n(remainder, remainder, divisor, length);
+    }
+
+    return quotient_high;
 }
 
-static void addition_bigint_and_word(Bigint **result, const Bigint *bigint, const Word word)
+/**
+ * @brief Divides 2*[length] words by [length] words with the recursion of Burnikel and Ziegler.
+ *
+ * The upper half of the quotient is computed from the top of the dividend, and the lower half
+ * from the partial remainder, both by division_recursive_top. So the division costs a few
+ * multiplications of half the length at each level of the recursion.
+ *
+ * @param quotient [output] [length] words of the quotient without its top bit.
+ * @param remainder [input/output] 2*[length] words of the dividend; [length] words of the remainder on return.
+ * @param divisor [input] Normalized divisor.
+ * @param length [input] Number of words of [divisor].
+ * @param threshold [input] Lengths of divisors below this are divided by division_schoolbook.
+ * @param product [input] Temporary Bigint for the products.
+ * @return Word Top bit of the quotient.
+ */
+static Word division_recursive(Word *quotient, Word *remainder, const Word *divisor, size_t length, size_t threshold, Bigint **product)
 {
-    Bigint *word_to_bigint = NULL;
-
-    /* Allocate Bigint */
-    bigint_new(&word_to_bigint, 1);
+    if (length < threshold)
+        return division_schoolbook(quotient, remainder, length * 2, divisor, length);
 
-    /* word to bigint for compatible */
-    word_to_bigint->digits[0] = word;
+    size_t length_low = length / 2;
+    size_t length_high = length - length_low;
 
-    /* multiplication between bigint and word */
-    bigint_addition(result, bigint, word_to_bigint);
+    Word quotient_high = division_recursive_top(quotient + length_low, remainder + length_low, divisor, length, length_high, threshold, product);
+    division_recursive_top(quotient, remainder, divisor, length, length_low, threshold, product); // no top bit: the upper half is reduced
 
-    /* Free Bigint */
-    bigint_delete(&word_to_bigint);
+    return quotient_high;
 }
 
-/*
-division_cc(A, B)
-Input: A = A_0 + A_1*W^1 + ... + A_n-1*W^n-1, B = B_0 + B_1*W^1 + ... + B_m-1*W^m-1
-(A_j , B_j ∈ [0, W), 0 < B ≤ A < BW, B_m−1 ≥ 2^w−1)
-Output: (Q, R) such that A = BQ + R (0 ≤ R < B, Q ∈ [0, W)).
-1: procedure division_cc(A, B)
-2: if n = m then
-3:  Q ← A_m-1/B_m-1 . Q ∈ [0, W)
-4: end if
-5: if n = m + 1 then
-6:  if A_m = B_m−1 then
-7:      Q ← W − 1
-8:  else . Am < Bm−1
-9:      Q ← 2word_long_div(A_mW + A_m−1, B_m−1) . Q ∈ [0, W)
-10: end if
-11: end if
-12: R ← A − BQ . Q ∈ [0, W)
-13: while R < 0 do
-14:     (Q, R) ← (Q − 1, R + B) . At most 2 computations
-15: end while
-16: return (Q, R)
-17: end procedure
-*/
-static void division_cc(Word *quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor)
+/**
+ * @brief Divides normalized word arrays with the algorithm of Burnikel and Ziegler.
+ *
+ * The quotient is computed in blocks of [length_d] words from the top, and each block
+ * by division_recursive_top. The first block takes the words left over.
+ * Same conditions as division_knuth.
+ *
+ * @param quotient [output] [length_r] - [length_d] words of the quotient.
+ * @param remainder [input/output] [length_r] words of the dividend; [length_d] words of the remainder on return.
+ * @param length_r [input] Number of words of [remainder] (greater than [length_d]).
+ * @param divisor [input] Normalized divisor.
+ * @param length_d [input] Number of words of [divisor].
+ * @param threshold [input] Lengths of divisors below this are divided by division_schoolbook.
+ */
+static void division_burnikel_ziegler(Word *quotient, Word *remainder, size_t length_r, const Word *divisor, size_t length_d,
+                                      size_t threshold)
 {
-    Word word_dividend_high = dividend->digits[divisor->digit_num];
-    Word word_dividend_low  = dividend->digits[divisor->digit_num - 1];
-    Word word_divisor       =  divisor->digits[divisor->digit_num - 1];
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint *product = NULL; // quotient block * part of divisor
+    bigint_scratch_new(&product, length_d);
 
-    if (dividend->digit_num == divisor->digit_num)
-        *quotient = word_dividend_low / word_divisor;
+    size_t idx = length_r - length_d;
+    size_t count = idx % length_d;
+    if (count == 0)
+        count = length_d;
 
-    if (dividend->digit_num == divisor->digit_num + 1)
+    while (idx > 0)
     {
-        if (word_dividend_high == word_divisor)
-            *quotient = -1;
-        else
-            *quotient = division_two_word(word_dividend_high, word_dividend_low, word_divisor);
+        idx -= count;
+        division_recursive_top(quotient + idx, remainder + idx, divisor, length_d, count, threshold, &product);
+        count = length_d;
     }
 
-    multiplication_bigint_and_word(remainder, divisor, *quotient); // R <- BQ
-    bigint_subtraction(remainder, dividend, *remainder);        // R <- A - BQ
+    bigint_delete(&product);
+    bigint_scratch_release(mark);
+}
 
-    while ((*remainder)->sign == NEGATIVE) // if (R < 0)
-    {
-        *quotient = *quotient - 1;                               // Q <- Q - 1
-        bigint_addition(remainder, *remainder, divisor); // R <- R - B
-    }
+/**
+ * @brief Divides with Algorithm D or Burnikel-Ziegler after normalizing the operands.
+ *
+ * Both operands are shifted once so that the most significant bit of the divisor is set,
+ * then the quotient is computed, and the remainder is shifted back.
+ *
+ * @param threshold [input] 0 for Algorithm D, else the threshold of division_burnikel_ziegler.
+ */
+static void division_normalized(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor, size_t threshold)
+{
+    /* Check invalid case or special case of division */
+    bool special_case_flag = bigint_division_special_case(quotient, remainder, dividend, divisor);
+    if (special_case_flag == true) return;
+
+    /* Number of digits: the dividend gets one more word for the bits shifted out */
+    size_t size_divisor = divisor->digit_num;
+    size_t size_dividend = dividend->digit_num + 1;
+
+    /* Shift amount that sets the most significant bit of the divisor */
+    unsigned int shift = 0;
+    while (GET_MSB((Word)(divisor->digits[size_divisor - 1] << shift)) == 0)
+        shift++;
+
+    /* Allocate Bigint */
+    Bigint *divisor_normalized = NULL;   // divisor << shift
+    Bigint *remainder_normalized = NULL; // dividend << shift, then remainder << shift
+    ScratchMark mark = bigint_scratch_mark();
+    bigint_scratch_new(&divisor_normalized, size_divisor);
+    bigint_scratch_new(&remainder_normalized, size_dividend);
+
+    /* Normalize */
+    word_array_shift_left(divisor_normalized->digits, divisor->digits, size_divisor, shift);
+    remainder_normalized->digits[size_dividend - 1] =
+        word_array_shift_left(remainder_normalized->digits, dividend->digits, size_dividend - 1, shift);
+
+    /* The operands are not read any more, so the outputs may be aliased with them */
+    bigint_new(quotient, size_dividend - size_divisor);
+    bigint_new(remainder, size_divisor);
+
+    /* Long division */
+    if (threshold == 0)
+        division_knuth((*quotient)->digits, remainder_normalized->digits, size_dividend, divisor_normalized->digits, size_divisor);
+    else
+        division_burnikel_ziegler((*quotient)->digits, remainder_normalized->digits, size_dividend,
+                                  divisor_normalized->digits, size_divisor, threshold);
+    word_array_shift_right((*remainder)->digits, remainder_normalized->digits, size_divisor, shift);
+
+    /* Get result */
+    bigint_refine(*quotient);
+    bigint_refine(*remainder);
+
+    /* Free Bigint */
+    bigint_delete(&divisor_normalized);
+    bigint_delete(&remainder_normalized);
+    bigint_scratch_release(mark);
 }
 
-/*
-division_c(a, b)
-input: A = A_0 + A_1*W^1 + ... + A_m*W^m, B = B_0 + B_1*W^1 + ... + B_m-1*W^m-1 (A_j, B_j ∈ [0, W), 0 ≤ A < BW)
-Output: (Q, R) such that A = BQ + R (0 ≤ R < B, Q ∈ [0, W)).
-1: procedure division_c(A, B)
-2: if A < B then
-3:  return (0, A)
-4: end if
-5: Compute k ∈ Z≥0 such that 2^k*B_m−1 ∈ [2^w−1, 2^w)
-6: A', B' ← 2^k*A, 2^k*B
-7: Q', R' ← division_cc(A', B')
-
-8: Q, R ← Q', 2^−k*R'
-9: return (Q, R)
-10: end procedure
-*/
-void division_c(Word *quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor)
+/**
+ * @brief Performs multi-precision long division (Knuth's Algorithm D).
+ *
+ * Divides the large integer [dividend] by [divisor] one quotient word at a time,
+ * so the cost is proportional to the product of the lengths of the quotient and the divisor.
+ * The formula is given by: A = BQ + R (where 0 <= R < B)
+ *
+ * @param quotient [output] The result of the quotient.
+ * @param remainder [output] The result of the remainder.
+ * @param dividend [input] Dividend large integer.
+ * @param divisor [input] Divisor large integer.
+ */
+void bigint_division_word_long(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor)
 {
-    /* Special Case : dividend < divisor */
-    if (bigint_compare(dividend, divisor) == LEFT_IS_SMALL) {
-        *quotient = 0;
-        bigint_copy(remainder, dividend);
-        return;
-    }
-    
-    Word count_shift = 0;
-    Word most_significant_word_of_divisor = divisor->digits[divisor->digit_num - 1];
+    division_normalized(quotient, remainder, dividend, divisor, 0);
+}
+
+/**
+ * @brief Performs divide-and-conquer division (Burnikel-Ziegler).
+ *
+ * Divides the large integer [dividend] by [divisor] with a recursion that reduces a division
+ * of 2n words by n words to two divisions of n words by n/2 words and two multiplications.
+ * The multiplications go through bigint_multiplication, so division gets faster with it.
+ * Divisors shorter than the division threshold are divided by Algorithm D at the bottom.
+ * The formula is given by: A = BQ + R (where 0 <= R < B)
+ *
+ * @param quotient [output] The result of the quotient.
+ * @param remainder [output] The result of the remainder.
+ * @param dividend [input] Dividend large integer.
+ * @param divisor [input] Divisor large integer.
+ */
+void bigint_division_burnikel_ziegler(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor)
+{
+    Thresholds thresholds;
+    bigint_get_thresholds(&thresholds);
 
-    Bigint *dividend_expand = NULL;
-    Bigint *divisor_expand = NULL;
+    division_normalized(quotient, remainder, dividend, divisor, thresholds.burnikel_ziegler);
+}
+
+/**
+ * @brief Divides with Burnikel-Ziegler or Algorithm D, whichever is faster for the lengths of the operands.
+ */
+static void division_by_length(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor)
+{
+    Thresholds thresholds;
+    bigint_get_thresholds(&thresholds);
+
+    size_t threshold = thresholds.burnikel_ziegler;
+
+    if (divisor->digit_num >= threshold && dividend->digit_num >= divisor->digit_num + threshold)
+        division_normalized(quotient, remainder, dividend, divisor, threshold);
+    else
+        division_normalized(quotient, remainder, dividend, divisor, 0);
+}
+
+/**
+ * @brief Computes floor(W^[power] / [divisor]) by Newton iteration with precision doubling.
+ *
+ * The reciprocal to half the precision is computed first, from the top words of [divisor],
+ * and shifted to an approximation X. One Newton step X <- X + X*(W^k - N*X) / W^k doubles
+ * its precision, then the error W^k - N*X is brought in [0, N) with a few corrections.
+ * Reciprocals of fewer than [threshold] words are computed by division_by_length.
+ *
+ * @param reciprocal [output] floor(W^[power] / [divisor]).
+ * @param divisor [input] Positive divisor.
+ * @param power [input] Exponent of W.
+ * @param threshold [input] Precision in words from which Newton iteration is used (at least 3).
+ */
+static void reciprocal_newton(Bigint **reciprocal, const Bigint *divisor, size_t power, size_t threshold)
+{
+    size_t length = divisor->digit_num;
 
     /* Allocate Bigint */
-    bigint_new(&dividend_expand, dividend->digit_num);
-    bigint_new(&divisor_expand, divisor->digit_num);
+    Bigint *power_of_word = NULL; // W^power
+    Bigint *error = NULL;         // W^power - divisor * reciprocal
+    ScratchMark mark = bigint_scratch_mark();
+    bigint_scratch_new(&power_of_word, power + 1);
+    bigint_scratch_new(&error, power + 1);
+    power_of_word->digits[power] = 1;
+
+    /* Small precision: divide (without length + threshold, which overflows for a disabled threshold) */
+    if (power < length || power - length < threshold) {
+        division_by_length(reciprocal, &error, power_of_word, divisor);
+    } else {
+        Bigint *product = NULL;
+        Bigint *difference = NULL; // X*E / W^k
+        Bigint *one = NULL;        // 1
+        bigint_scratch_new(&product, power + 2);
+        bigint_scratch_new(&difference, power + 2);
+        bigint_scratch_new(&one, 1);
+        bigint_set_one(&one);
+
+        /* The reciprocal has at most precision + 1 words; half of them come from the recursion */
+        size_t precision = power - length;
+        size_t precision_half = precision / 2 + 1;
+        size_t shift = precision - precision_half;
+        size_t truncation = (length > precision_half + 2) ? length - precision_half - 2 : 0;
+
+        /* X <- floor(W^(power - shift - truncation) / (divisor >> truncation words)) * W^shift */
+        Bigint divisor_high = bigint_view_part(divisor, truncation, length);
+        reciprocal_newton(reciprocal, &divisor_high, power - shift - truncation, threshold);
+        bigint_expand(reciprocal, *reciprocal, shift);
+
+        /* E <- W^k - N*X */
+        bigint_multiplication(&product, divisor, *reciprocal);
+        bigint_subtraction(&error, power_of_word, product);
+
+        /* D <- X*E / W^k: the low words of E change D by less than one */
+        size_t error_shift = (length > 2) ? length - 2 : 0;
+        Sign error_sign = error->sign;
+        Bigint error_high = bigint_view_part(error, error_shift, error->digit_num);
+        bigint_multiplication(&product, *reciprocal, &error_high);
+        bigint_compress(&difference, product, power - error_shift);
+        difference->sign = bigint_is_zero(difference) ? POSITIVE : error_sign;
+
+        /* X <- X + D, E <- E - N*D */
+        bigint_addition_inplace(reciprocal, difference);
+        bigint_multiplication(&product, divisor, difference);
+        bigint_subtraction_inplace(&error, product);
+
+        /* Bring E in [0, N) */
+        while (error->sign == NEGATIVE)
+        {
+            bigint_subtraction_inplace(reciprocal, one);
+            bigint_addition_inplace(&error, divisor);
+        }
+        while (bigint_compare(error, divisor) != LEFT_IS_SMALL)
+        {
+            bigint_addition_inplace(reciprocal, one);
+            bigint_subtraction_inplace(&error, divisor);
+        }
 
-    /* init */
-    bigint_copy(&dividend_expand, dividend);
-    bigint_copy(&divisor_expand, divisor);
+        bigint_delete(&product);
+        bigint_delete(&difference);
+        bigint_delete(&one);
+    }
 
-    /* expand */
-    while (GET_MSB(most_significant_word_of_divisor) != 1)
-    {
-        bigint_expand_one_bit(&dividend_expand, dividend_expand);
-        bigint_expand_one_bit(&divisor_expand, divisor_expand); 
+    /* Free Bigint */
+    bigint_delete(&power_of_word);
+    bigint_delete(&error);
+    bigint_scratch_release(mark);
+}
 
-        most_significant_word_of_divisor <<= 1;
-        count_shift++;
+/**
+ * @brief Computes the reciprocal floor(W^[power] / [divisor]).
+ *
+ * Long reciprocals are computed by Newton iteration (see reciprocal_newton), which costs
+ * a few multiplications of the length of the reciprocal. It is the pre-computed value of
+ * Barrett reduction with [power] = 2n, and bigint_division_newton divides with it.
+ *
+ * @param reciprocal [output] floor(W^[power] / [divisor]).
+ * @param divisor [input] Positive divisor.
+ * @param power [input] Exponent of W.
+ */
+void bigint_reciprocal(Bigint **reciprocal, const Bigint *divisor, size_t power)
+{
+    /* Invalid case: zero or negative divisor */
+    if (bigint_is_zero(divisor) == TRUE || divisor->sign == NEGATIVE)
+    {
+        printf("divisor must be positive\n"); // error log
+        bigint_set_zero(reciprocal);
+        return;
     }
 
-    /* div */
-    division_cc(quotient, remainder, dividend_expand, divisor_expand);
+    Thresholds thresholds;
+    bigint_get_thresholds(&thresholds);
 
-    /* compress */
-    while(count_shift--)
-        bigint_compress_one_bit(remainder, *remainder);
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint *tmp_reciprocal = NULL; // Used only if [reciprocal] is aliased with [divisor].
+
+    /* Allocate Bigint */
+    Bigint **output = bigint_output_new(reciprocal, &tmp_reciprocal, power + 1, divisor, NULL);
+
+    reciprocal_newton(output, divisor, power, thresholds.newton);
+
+    /* Get result */
+    bigint_output_finish(reciprocal, &tmp_reciprocal);
 
     /* Free Bigint */
-    bigint_delete(&dividend_expand);
-    bigint_delete(&divisor_expand);
+    bigint_scratch_release(mark);
 }
 
-/*
-Multi-Precision Long Division
-A = A_0 + A_1*W^1 + ... + A_n-1*W^n-1, B (A_j ∈ [0, W))
-Output: (Q = Q_0 + Q_1*W^1 + ... + Q_n-1*W^n-1, R)
-such that A = BQ + R (0 ≤ R < B, Q_j ∈ [0, W)).
-1: procedure DIVlong(A, B)
-2: if A < B then
-3: return (0, A)
-4: end if
-5: R_n ← 0
-6: for i = n − 1 downto 0 do
-7: (Q_i, R_i) ← division_c(R_i+1*W + A_i, B).
-8: end for
-9: Q ← Q_0 + Q_1*W + ... + Q_n−1*W^n−1
-10: return (Q, R0)
-11: end procedure
-*/
-void bigint_division_word_long(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor)
+/**
+ * @brief Performs division by multiplication with the reciprocal of the divisor (Newton).
+ *
+ * With k the length of [dividend] and n the length of [divisor], the quotient is estimated
+ * like Barrett reduction: Q' = (A >> W^(n-1)) * floor(W^k / B) >> W^(k-n+1) is Q, Q-1 or Q-2.
+ * So the quotient costs one reciprocal (bigint_reciprocal) and one multiplication of the
+ * length of the quotient, and the remainder one more multiplication and a few corrections.
+ * The formula is given by: A = BQ + R (where 0 <= R < B)
+ *
+ * @param quotient [output] The result of the quotient.
+ * @param remainder [output] The result of the remainder.
+ * @param dividend [input] Dividend large integer.
+ * @param divisor [input] Divisor large integer.
+ */
+void bigint_division_newton(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor)
 {
     /* Check invalid case or special case of division */
     bool special_case_flag = bigint_division_special_case(quotient, remainder, dividend, divisor);
     if (special_case_flag == true) return;
 
-    /* Number of digits about quotient and remainder */
-    Word size_quotient = dividend->digit_num - divisor->digit_num + 1;
-    Word size_remainder = divisor->digit_num;
+    size_t power = dividend->digit_num;
+    size_t shift = divisor->digit_num - 1;
 
-    /* Allocate Bigint */
-    Bigint *tmp_quotient = NULL;       // result of quotient
-    Bigint *tmp_remainder = NULL;      // result of remainder
-    Bigint *rw_plus_a = NULL;          // result of remainder with addition
+    /* Allocate Bigint: the outputs are written in place unless aliased with the operands */
+    Bigint *tmp_quotient = NULL;  // Used only if [quotient] is aliased with an operand.
+    Bigint *tmp_remainder = NULL; // Used only if [remainder] is aliased with an operand.
+    Bigint *product = NULL;
+    Bigint *one = NULL;           // 1
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint **output_quotient = bigint_output_new(quotient, &tmp_quotient, power + 1, dividend, divisor);
+    Bigint **output_remainder = bigint_output_new(remainder, &tmp_remainder, power + 1, dividend, divisor);
+    bigint_scratch_new(&product, power * 2 + 1);
+    bigint_scratch_new(&one, 1);
+    bigint_set_one(&one);
 
-    // (rwa->digits[0] = remainder->digits[i], rwa->digits[1] = tmp_remainder->digits[i+1])
-    bigint_new(&tmp_quotient, size_quotient);
-    bigint_new(&tmp_remainder, size_remainder);
-    bigint_new(&rw_plus_a, size_remainder + 1);
+    /* Q <- (A >> W^(n-1)) * floor(W^k / B) >> W^(k-n+1) */
+    Bigint dividend_high = bigint_view_part(dividend, shift, dividend->digit_num);
+    bigint_reciprocal(output_quotient, divisor, power);
+    bigint_multiplication(&product, &dividend_high, *output_quotient);
+    bigint_compress(output_quotient, product, power - shift);
 
-    /* init */
-    bigint_set_zero(&tmp_quotient);
-    bigint_set_zero(&tmp_remainder);
+    /* R <- A - QB, then correct Q */
+    bigint_multiplication(&product, *output_quotient, divisor);
+    bigint_subtraction(output_remainder, dividend, product);
 
-    /* long div */
-    for (int digit_idx = dividend->digit_num - 1; digit_idx >= 0; digit_idx--)
+    while (bigint_compare(*output_remainder, divisor) != LEFT_IS_SMALL)
     {
-        Word word_dividend = dividend->digits[digit_idx];
-        Word word_quotient = 0;
+        bigint_addition_inplace(output_quotient, one);
+        bigint_subtraction_inplace(output_remainder, divisor);
+    }
+
+    /* Get result */
+    bigint_output_finish(quotient, &tmp_quotient);
+    bigint_output_finish(remainder, &tmp_remainder);
 
-        /* rwa = tmp_remainder*W + dividend->digits[digit_idx] */
-        bigint_expand(&rw_plus_a, tmp_remainder, 1);
-        addition_bigint_and_word(&rw_plus_a, rw_plus_a, word_dividend);
+    /* Free Bigint */
+    bigint_delete(&product);
+    bigint_delete(&one);
+    bigint_scratch_release(mark);
+}
 
-        division_c(&word_quotient, &tmp_remainder, rw_plus_a, divisor);
-        bigint_expand(&tmp_quotient, tmp_quotient, 1);
-        addition_bigint_and_word(&tmp_quotient, tmp_quotient, word_quotient);
+/**
+ * @brief Performs division with the fastest algorithm for the lengths of the operands.
+ *
+ * Newton (division by the reciprocal) is used if both the divisor and the quotient have
+ * at least the Newton threshold of digits, Burnikel-Ziegler if they have at least its
+ * threshold, and Algorithm D otherwise.
+ * The formula is given by: A = BQ + R (where 0 <= R < B)
+ *
+ * @param quotient [output] The result of the quotient.
+ * @param remainder [output] The result of the remainder.
+ * @param dividend [input] Dividend large integer.
+ * @param divisor [input] Divisor large integer.
+ */
+void bigint_division(Bigint **quotient, Bigint **remainder, const Bigint *dividend, const Bigint *divisor)
+{
+    Thresholds thresholds;
+    bigint_get_thresholds(&thresholds);
+
+    size_t threshold = thresholds.newton;
+
+    /* Single-word divisor: one pass, without normalized copies of the operands */
+    if (divisor->digit_num == 1 && divisor->sign == POSITIVE && dividend->sign == POSITIVE && !bigint_is_zero(divisor)) {
+        Word word_remainder = bigint_division_word(quotient, dividend, divisor->digits[0]);
+        bigint_set_zero(remainder);
+        (*remainder)->digits[0] = word_remainder;
+        return;
     }
 
+    if (divisor->digit_num >= threshold && dividend->digit_num >= divisor->digit_num + threshold)
+        bigint_division_newton(quotient, remainder, dividend, divisor);
+    else
+        division_by_length(quotient, remainder, dividend, divisor);
+}
+
+/**
+ * @brief Divides a large integer by a single word.
+ *
+ * [quotient] <- [dividend] / [divisor] in one pass from the most significant digit,
+ * and the remainder is returned, so no Bigint is allocated for it.
+ * [quotient] may be the same object as [dividend].
+ * The formula is given by: A = BQ + R (where 0 <= R < B)
+ *
+ * @param quotient [output] The result of the quotient.
+ * @param dividend [input] Dividend large integer.
+ * @param divisor [input] Divisor word.
+ * @return Word The remainder.
+ */
+Word bigint_division_word(Bigint **quotient, const Bigint *dividend, Word divisor)
+{
+    /* Invalid case: zero divisor */
+    if (divisor == 0)
+    {
+        printf("divisor must be non-zero\n"); // error log
+        bigint_set_zero(quotient);
+        return 0;
+    }
+
+    /* Invalid case: negative dividend */
+    if (dividend->sign == NEGATIVE)
+    {
+        printf("divisor and dividend must be positive\n"); // error log
+        bigint_set_zero(quotient);
+        return 0;
+    }
+
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint *tmp_quotient = NULL; // Used only if [quotient] is aliased with [dividend].
+
+    /* Allocate Bigint */
+    Bigint **output = bigint_output_new(quotient, &tmp_quotient, dividend->digit_num, dividend, NULL);
+
+    /* Long division by a word */
+    Word remainder = word_array_divrem_1((*output)->digits, dividend->digits, dividend->digit_num, divisor);
+
     /* Get result */
-    bigint_refine(tmp_quotient);
-    bigint_refine(tmp_remainder);
-    bigint_copy(quotient, tmp_quotient);
-    bigint_copy(remainder, tmp_remainder);
+    bigint_refine(*output);
+    bigint_output_finish(quotient, &tmp_quotient);
 
     /* Free Bigint */
-    bigint_delete(&tmp_quotient);
-    bigint_delete(&tmp_remainder);
-    bigint_delete(&rw_plus_a);
-}
\ No newline at end of file
+    bigint_scratch_release(mark);
+
+    return remainder;
+}
+
+/**
+ * @brief Divides a large integer by a single word in place.
+ *
+ * [bigint] <- [bigint] / [divisor], without allocating a new result.
+ * This is the inner step of radix conversion and trial division.
+ *
+ * @param bigint [input/output] Memory address of the dividend, then of the quotient.
+ * @param divisor [input] Divisor word.
+ * @return Word The remainder.
+ */
+Word bigint_division_word_inplace(Bigint **bigint, Word divisor)
+{
+    /* Invalid case: zero divisor */
+    if (divisor == 0)
+    {
+        printf("divisor must be non-zero\n"); // error log
+        bigint_set_zero(bigint);
+        return 0;
+    }
+
+    /* Invalid case: negative dividend */
+    if ((*bigint)->sign == NEGATIVE)
+    {
+        printf("divisor and dividend must be positive\n"); // error log
+        bigint_set_zero(bigint);
+        return 0;
+    }
+
+    Word remainder = word_array_divrem_1((*bigint)->digits, (*bigint)->digits, (*bigint)->digit_num, divisor);
+    bigint_refine(*bigint);
+
+    return remainder;
+}
@@ -1,5 +1,31 @@
 #include "autobahn.h"
 
+/**
+ * @brief Prepares the Barrett reduction for modular exponentiation.
+ * 
+ * Reduces [base] modulo [modular] and computes the pre-computed value of Barrett reduction,
+ * so every product in the loop is less than N^2 and can be reduced with bigint_reduction_barrett_inplace.
+ * 
+ * @param base_reduced [output] [base] mod [modular].
+ * @param pre_computed [output] Pre-computed value for Barrett reduction.
+ * @param base [input] The base value.
+ * @param modular [input] The modulus value.
+ */
+static void exponentiation_barrett_setup(Bigint** base_reduced, Bigint** pre_computed, const Bigint* base, const Bigint* modular)
+{
+    bigint_reduction_barrett_pre_computed(pre_computed, modular);
+
+    /* Barrett reduction needs the base in W^2n */
+    if (base->digit_num <= modular->digit_num * 2) {
+        bigint_copy(base_reduced, base);
+        bigint_reduction_barrett_inplace(base_reduced, modular, *pre_computed);
+    } else {
+        Bigint* quotient = NULL;
+        bigint_division(&quotient, base_reduced, base, modular);
+        bigint_delete(&quotient);
+    }
+}
+
 /**
  * @brief Exponentiation using the left-to-right method.
  * 
@@ -21,19 +47,23 @@ void bigint_exponentiation_left_to_right(Bigint** result, const Bigint* base, co
 
     /* Allocate Bigint and initialize for algorithm */
     Bigint* result_tmp = NULL;
+    Bigint* result_next = NULL; // The product is written here, then swapped with result_tmp.
     bigint_new(&result_tmp, 1);
     bigint_set_one(&result_tmp);
 
     /* Iteration count */
-    Word bitlen = bigint_get_bit_length(exponent);
+    size_t bitlen = bigint_get_bit_length(exponent);
 
     /* Left-to-right */
     while (bitlen--)
     {
-        //bigint_squaring(&result_tmp, result_tmp); // always squaring.
+        bigint_squaring(&result_next, result_tmp); // always squaring.
+        bigint_swap(&result_tmp, &result_next);
 
-        if (bigint_get_bit(exponent, bitlen) == 1)
-            bigint_multiplication_textbook(&result_tmp, result_tmp, base); // conditional multiplication.
+        if (bigint_get_bit(exponent, bitlen) == 1) {
+            bigint_multiplication(&result_next, result_tmp, base);          // conditional multiplication.
+            bigint_swap(&result_tmp, &result_next);
+        }
     }
 
     /* get result */
@@ -42,6 +72,7 @@ void bigint_exponentiation_left_to_right(Bigint** result, const Bigint* base, co
 
     /* Free Bigint */
     bigint_delete(&result_tmp);
+    bigint_delete(&result_next);
 }
 
 /**
@@ -67,22 +98,27 @@ void bigint_exponentiation_montgomery_ladder(Bigint** result, const Bigint* base
     /* Allocate Bigint and initailize for algorithm */
     Bigint* left = NULL; // result
     Bigint* right = NULL;
+    Bigint* product = NULL; // The product is written here, then swapped with left or right.
     bigint_set_one(&left); // left = 1
     bigint_copy(&right, base);           // right = x
 
     /* Iteration count */
-    Word bitlen = bigint_get_bit_length(exponent);
+    size_t bitlen = bigint_get_bit_length(exponent);
 
     /* Montgomery Ladder */
     while (bitlen--)
     {
         if (bigint_get_bit(exponent, bitlen)) {
-            bigint_multiplication_textbook(&left, left, right);  // always multiplication
-            //bigint_squaring(&right, right);             // always squaring
+            bigint_multiplication(&product, left, right);           // always multiplication
+            bigint_swap(&left, &product);
+            bigint_squaring(&product, right);                       // always squaring
+            bigint_swap(&right, &product);
         } 
         else {
-            bigint_multiplication_textbook(&right, right, left); // note: result is in right. not left.
-            //bigint_squaring(&left, left);               // note: result is int left. not right
+            bigint_multiplication(&product, right, left);          // note: result is in right. not left.
+            bigint_swap(&right, &product);
+            bigint_squaring(&product, left);                       // note: result is int left. not right
+            bigint_swap(&left, &product);
         }
     }
 
@@ -92,6 +128,8 @@ void bigint_exponentiation_montgomery_ladder(Bigint** result, const Bigint* base
 
     /* Free Bigint */
     bigint_delete(&left);
+    bigint_delete(&right);
+    bigint_delete(&product);
 }
 
 /**
@@ -116,29 +154,43 @@ void bigint_exponentiation_modular_left_to_right(Bigint** result, const Bigint*
 
     /* Allocate Bigint and initialize for algorithm */
     Bigint* result_tmp = NULL;
+    Bigint* result_next = NULL; // The product is written here, then swapped with result_tmp.
+    Bigint* base_reduced = NULL;
+    Bigint* pre_computed = NULL;
     bigint_new(&result_tmp, 1);
     bigint_set_one(&result_tmp);
+    exponentiation_barrett_setup(&base_reduced, &pre_computed, base, modular);
 
     /* Iteration count */
-    Word bitlen = bigint_get_bit_length(exponent);
+    size_t bitlen = bigint_get_bit_length(exponent);
 
     /* Left-to-right */
     while (bitlen--)
     {
-        //bigint_squaring(&result_tmp, result_tmp); // always squaring.
-        //bigint_modular_barrett(&result_tmp, modular);        
+        bigint_squaring(&result_next, result_tmp); // always squaring.
+        bigint_swap(&result_tmp, &result_next);
+        bigint_reduction_barrett_inplace(&result_tmp, modular, pre_computed);
 
-        if (bigint_get_bit(exponent, bitlen) == 1)
-            bigint_multiplication_textbook(&result_tmp, result_tmp, base); // conditional multiplication.
-            //bigint_modular_barrett(&result_tmp, modular);        
+        if (bigint_get_bit(exponent, bitlen) == 1) {
+            bigint_multiplication(&result_next, result_tmp, base_reduced);          // conditional multiplication.
+            bigint_swap(&result_tmp, &result_next);
+            bigint_reduction_barrett_inplace(&result_tmp, modular, pre_computed);
+        }
     }
 
+    /* 1 mod N */
+    if (bigint_is_one(modular))
+        bigint_set_zero(&result_tmp);
+
     /* get result */
     bigint_refine(result_tmp);
     bigint_copy(result, result_tmp);
 
     /* Free Bigint */
     bigint_delete(&result_tmp);
+    bigint_delete(&result_next);
+    bigint_delete(&base_reduced);
+    bigint_delete(&pre_computed);
 }
 
 /**
@@ -166,33 +218,46 @@ void bigint_exponentiation_modular_montgomery_ladder(Bigint** result, const Bigi
     /* Allocate Bigint and initailize for algorithm */
     Bigint* left = NULL; // result
     Bigint* right = NULL;
+    Bigint* product = NULL; // The product is written here, then swapped with left or right.
+    Bigint* pre_computed = NULL;
     bigint_set_one(&left); // left = 1
-    bigint_copy(&right, base);           // right = x
+    exponentiation_barrett_setup(&right, &pre_computed, base, modular); // right = x mod N
 
     /* Iteration count */
-    Word bitlen = bigint_get_bit_length(exponent);
+    size_t bitlen = bigint_get_bit_length(exponent);
 
     /* Montgomery Ladder */
     while (bitlen--)
     {
         if (bigint_get_bit(exponent, bitlen)) {
-            bigint_multiplication_textbook(&left, left, right);  // always multiplication
-            //bigint_modular_barrett();
-            //bigint_squaring(&right, right);             // always squaring
-            //bigint_modular_barrett();
+            bigint_multiplication(&product, left, right);           // always multiplication
+            bigint_swap(&left, &product);
+            bigint_reduction_barrett_inplace(&left, modular, pre_computed);
+            bigint_squaring(&product, right);                       // always squaring
+            bigint_swap(&right, &product);
+            bigint_reduction_barrett_inplace(&right, modular, pre_computed);
         } 
         else {
-            bigint_multiplication_textbook(&right, right, left); // note: result is in right. not left.
-            //bigint_modular_barrett();
-            //bigint_squaring(&left, left);               // note: result is int left. not right
-            //bigint_modular_barrett();
+            bigint_multiplication(&product, right, left);          // note: result is in right. not left.
+            bigint_swap(&right, &product);
+            bigint_reduction_barrett_inplace(&right, modular, pre_computed);
+            bigint_squaring(&product, left);                       // note: result is int left. not right
+            bigint_swap(&left, &product);
+            bigint_reduction_barrett_inplace(&left, modular, pre_computed);
         }
     }
 
+    /* 1 mod N */
+    if (bigint_is_one(modular))
+        bigint_set_zero(&left);
+
     /* Get result */
     bigint_refine(left);
     bigint_copy(result, left);
 
     /* Free Bigint */
     bigint_delete(&left);
+    bigint_delete(&right);
+    bigint_delete(&product);
+    bigint_delete(&pre_computed);
 }
\ No newline at end of file
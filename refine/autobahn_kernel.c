@@ -0,0 +1,678 @@
+#include "autobahn_kernel.h"
+
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(BI_WORD64)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <immintrin.h>
+    #endif
+    #define WORD_ADD_WITH_CARRY_INTRINSIC   _addcarry_u64   ///< ADC on x86-64
+    #define WORD_SUB_WITH_BORROW_INTRINSIC  _subborrow_u64  ///< SBB on x86-64
+    typedef unsigned long long IntrinsicWord;
+#elif (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)) && defined(BI_WORD32)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <immintrin.h>
+    #endif
+    #define WORD_ADD_WITH_CARRY_INTRINSIC   _addcarry_u32
+    #define WORD_SUB_WITH_BORROW_INTRINSIC  _subborrow_u32
+    typedef unsigned int IntrinsicWord;
+#endif
+
+/*
+ * Largest number of products in a Comba column: W/2 products of at most (W-1)^2
+ * and the carry of the previous column (below W^2) stay below W^3.
+ */
+#if defined(BI_WORD8)
+    #define COMBA_COLUMN_MAX ((size_t)1 << 7)
+#elif defined(BI_WORD32)
+    #define COMBA_COLUMN_MAX ((size_t)1 << 31)
+#else
+    #define COMBA_COLUMN_MAX SIZE_MAX ///< 2^63 words cannot be allocated.
+#endif
+
+#if !defined(WORD_ADD_WITH_CARRY_INTRINSIC) && defined(__has_builtin)
+    #if defined(BI_WORD64) && __has_builtin(__builtin_addcll) && __has_builtin(__builtin_subcll)
+        #define WORD_ADD_WITH_CARRY_BUILTIN     __builtin_addcll    ///< ADCS on AArch64 with clang
+        #define WORD_SUB_WITH_BORROW_BUILTIN    __builtin_subcll
+        typedef unsigned long long BuiltinWord;
+    #elif defined(BI_WORD32) && __has_builtin(__builtin_addc) && __has_builtin(__builtin_subc)
+        #define WORD_ADD_WITH_CARRY_BUILTIN     __builtin_addc
+        #define WORD_SUB_WITH_BORROW_BUILTIN    __builtin_subc
+        typedef unsigned int BuiltinWord;
+    #endif
+#endif
+
+/**
+ * @brief Adds two words and a carry, and returns the next carry.
+ *
+ * The addition is mapped onto the add-with-carry instruction of the target
+ * when the compiler exposes it (_addcarry_u64/_addcarry_u32 on x86, 
+ * __builtin_addcll/__builtin_addc with clang), so the carry stays in the
+ * carry flag along an unrolled chain. Otherwise it is computed with compares.
+ *
+ * carry condition : let r = x + y. if r < x(or y) then carry is set.
+ *
+ * @param result [output] x + y + carry.
+ * @param carry [input] Carry from the previous addition (0 or 1).
+ * @param operand_x [input] First operand of the addition.
+ * @param operand_y [input] Second operand of the addition.
+ * @return Word Carry from the current addition.
+ */
+static inline Word word_addition_with_carry(Word* result, Word carry, Word operand_x, Word operand_y)
+{
+#if defined(WORD_ADD_WITH_CARRY_INTRINSIC)
+    IntrinsicWord sum;
+    carry = WORD_ADD_WITH_CARRY_INTRINSIC((unsigned char)carry, operand_x, operand_y, &sum);
+    *result = (Word)sum;
+    return carry;
+#elif defined(WORD_ADD_WITH_CARRY_BUILTIN)
+    BuiltinWord next_carry;
+    *result = (Word)WORD_ADD_WITH_CARRY_BUILTIN(operand_x, operand_y, carry, &next_carry);
+    return (Word)next_carry;
+#else
+    Word sum = operand_x + operand_y;   // r = x + y
+    Word next_carry = (sum < operand_x); // set carry
+    sum += carry;                        // r = x + y + c
+    next_carry += (sum < carry);         // set carry
+    *result = sum;
+    return next_carry;
+#endif
+}
+
+/**
+ * @brief Subtracts two words and a borrow, and returns the next borrow.
+ *
+ * Like word_addition_with_carry, this is mapped onto the subtract-with-borrow instruction when possible.
+ *
+ * borrow condition : let r = x - y. if x < y then borrow is set.
+ *
+ * @param result [output] x - y - borrow.
+ * @param borrow [input] Borrow from the previous subtraction (0 or 1).
+ * @param operand_x [input] First operand of the subtraction.
+ * @param operand_y [input] Second operand of the subtraction.
+ * @return Word Borrow from the current subtraction.
+ */
+static inline Word word_subtraction_with_borrow(Word* result, Word borrow, Word operand_x, Word operand_y)
+{
+#if defined(WORD_SUB_WITH_BORROW_INTRINSIC)
+    IntrinsicWord difference;
+    borrow = WORD_SUB_WITH_BORROW_INTRINSIC((unsigned char)borrow, operand_x, operand_y, &difference);
+    *result = (Word)difference;
+    return borrow;
+#elif defined(WORD_SUB_WITH_BORROW_BUILTIN)
+    BuiltinWord next_borrow;
+    *result = (Word)WORD_SUB_WITH_BORROW_BUILTIN(operand_x, operand_y, borrow, &next_borrow);
+    return (Word)next_borrow;
+#else
+    Word difference = operand_x - operand_y;     // r = x - y
+    Word next_borrow = (operand_x < operand_y);  // set borrow
+    next_borrow += (difference < borrow);        // set borrow
+    *result = difference - borrow;               // r = x - y - b
+    return next_borrow;
+#endif
+}
+
+/**
+ * @brief Compares two word arrays of the same length.
+ *
+ * @param operand_x [input] First word array.
+ * @param operand_y [input] Second word array.
+ * @param length [input] Number of words of both arrays.
+ * @return int LEFT_IS_BIG, SAME or LEFT_IS_SMALL.
+ */
+int word_array_compare(const Word* operand_x, const Word* operand_y, size_t length)
+{
+    while (length--)
+    {
+        if (operand_x[length] > operand_y[length]) return LEFT_IS_BIG;
+        if (operand_x[length] < operand_y[length]) return LEFT_IS_SMALL;
+    }
+
+    return SAME;
+}
+
+/**
+ * @brief Computes the number of words without leading zero words.
+ *
+ * The result is at least 1, so zero has the length 1 like a refined Bigint.
+ *
+ * @param operand [input] Word array.
+ * @param length [input] Number of words of [operand].
+ * @return size_t Refined number of words.
+ */
+size_t word_array_refined_length(const Word* operand, size_t length)
+{
+    while (length > 1 && operand[length - 1] == 0)
+        length--;
+
+    return (length == 0) ? 1 : length;
+}
+
+/**
+ * @brief Adds two word arrays of the same length.
+ *
+ * carry condition : let r = x + y. if r < x(or y) then carry is set.
+ *
+ * @param result [output] [length] words of x + y.
+ * @param operand_x [input] First operand.
+ * @param operand_y [input] Second operand.
+ * @param length [input] Number of words of the operands.
+ * @return Word Carry out of the most significant word (0 or 1).
+ */
+Word word_array_add_n(Word* result, const Word* operand_x, const Word* operand_y, size_t length)
+{
+    Word carry = 0;
+    size_t idx = 0;
+
+    /* Unrolled carry chain: four words per iteration */
+    for (; idx + 4 <= length; idx += 4)
+    {
+        carry = word_addition_with_carry(&result[idx],     carry, operand_x[idx],     operand_y[idx]);
+        carry = word_addition_with_carry(&result[idx + 1], carry, operand_x[idx + 1], operand_y[idx + 1]);
+        carry = word_addition_with_carry(&result[idx + 2], carry, operand_x[idx + 2], operand_y[idx + 2]);
+        carry = word_addition_with_carry(&result[idx + 3], carry, operand_x[idx + 3], operand_y[idx + 3]);
+    }
+
+    /* Remaining words */
+    for (; idx < length; idx++)
+        carry = word_addition_with_carry(&result[idx], carry, operand_x[idx], operand_y[idx]);
+
+    return carry;
+}
+
+/**
+ * @brief Adds a single word to a word array.
+ *
+ * @param result [output] [length] words of x + word.
+ * @param operand_x [input] Word array operand.
+ * @param length [input] Number of words of [operand_x].
+ * @param word [input] Word to add.
+ * @return Word Carry out of the most significant word (0 or 1).
+ */
+Word word_array_add_1(Word* result, const Word* operand_x, size_t length, Word word)
+{
+    Word carry = word;
+    size_t idx = 0;
+
+    /* Propagate the carry until it dies */
+    for (; carry && idx < length; idx++)
+    {
+        Word sum = operand_x[idx] + carry;
+        carry = (sum < carry);
+        result[idx] = sum;
+    }
+
+    /* The rest of the words are unchanged */
+    if (result != operand_x)
+        memcpy(result + idx, operand_x + idx, (length - idx) * SIZE_OF_WORD);
+
+    return carry;
+}
+
+/**
+ * @brief Adds two word arrays of different lengths.
+ *
+ * The carry chain runs over the common [length_y] words first and is then
+ * propagated through the remaining words of [operand_x] only until it dies.
+ * It is assumed that [length_x] is larger than or equal to [length_y].
+ *
+ * @param result [output] [length_x] words of x + y.
+ * @param operand_x [input] Longer operand.
+ * @param length_x [input] Number of words of [operand_x].
+ * @param operand_y [input] Shorter operand.
+ * @param length_y [input] Number of words of [operand_y].
+ * @return Word Carry out of the most significant word (0 or 1).
+ */
+Word word_array_add(Word* result, const Word* operand_x, size_t length_x, const Word* operand_y, size_t length_y)
+{
+    Word carry = word_array_add_n(result, operand_x, operand_y, length_y);
+
+    return word_array_add_1(result + length_y, operand_x + length_y, length_x - length_y, carry);
+}
+
+/**
+ * @brief Subtracts two word arrays of the same length.
+ *
+ * borrow condition : let r = x - y. if x < y then borrow is set.
+ *
+ * @param result [output] [length] words of x - y.
+ * @param operand_x [input] First operand.
+ * @param operand_y [input] Second operand.
+ * @param length [input] Number of words of the operands.
+ * @return Word Borrow out of the most significant word (0 or 1).
+ */
+Word word_array_sub_n(Word* result, const Word* operand_x, const Word* operand_y, size_t length)
+{
+    Word borrow = 0;
+    size_t idx = 0;
+
+    /* Unrolled borrow chain: four words per iteration */
+    for (; idx + 4 <= length; idx += 4)
+    {
+        borrow = word_subtraction_with_borrow(&result[idx],     borrow, operand_x[idx],     operand_y[idx]);
+        borrow = word_subtraction_with_borrow(&result[idx + 1], borrow, operand_x[idx + 1], operand_y[idx + 1]);
+        borrow = word_subtraction_with_borrow(&result[idx + 2], borrow, operand_x[idx + 2], operand_y[idx + 2]);
+        borrow = word_subtraction_with_borrow(&result[idx + 3], borrow, operand_x[idx + 3], operand_y[idx + 3]);
+    }
+
+    /* Remaining words */
+    for (; idx < length; idx++)
+        borrow = word_subtraction_with_borrow(&result[idx], borrow, operand_x[idx], operand_y[idx]);
+
+    return borrow;
+}
+
+/**
+ * @brief Subtracts a single word from a word array.
+ *
+ * @param result [output] [length] words of x - word.
+ * @param operand_x [input] Word array operand.
+ * @param length [input] Number of words of [operand_x].
+ * @param word [input] Word to subtract.
+ * @return Word Borrow out of the most significant word (0 or 1).
+ */
+Word word_array_sub_1(Word* result, const Word* operand_x, size_t length, Word word)
+{
+    Word borrow = word;
+    size_t idx = 0;
+
+    /* Propagate the borrow until it dies */
+    for (; borrow && idx < length; idx++)
+    {
+        Word difference = operand_x[idx] - borrow;
+        borrow = (operand_x[idx] < borrow);
+        result[idx] = difference;
+    }
+
+    /* The rest of the words are unchanged */
+    if (result != operand_x)
+        memcpy(result + idx, operand_x + idx, (length - idx) * SIZE_OF_WORD);
+
+    return borrow;
+}
+
+/**
+ * @brief Subtracts two word arrays of different lengths.
+ *
+ * It is assumed that [length_x] is larger than or equal to [length_y].
+ *
+ * @param result [output] [length_x] words of x - y.
+ * @param operand_x [input] Longer operand.
+ * @param length_x [input] Number of words of [operand_x].
+ * @param operand_y [input] Shorter operand.
+ * @param length_y [input] Number of words of [operand_y].
+ * @return Word Borrow out of the most significant word (0 or 1).
+ */
+Word word_array_sub(Word* result, const Word* operand_x, size_t length_x, const Word* operand_y, size_t length_y)
+{
+    Word borrow = word_array_sub_n(result, operand_x, operand_y, length_y);
+
+    return word_array_sub_1(result + length_y, operand_x + length_y, length_x - length_y, borrow);
+}
+
+/**
+ * @brief Multiplies a word array by a single word.
+ *
+ * @param result [output] [length] words of x * word.
+ * @param operand_x [input] Word array operand.
+ * @param length [input] Number of words of [operand_x].
+ * @param word [input] Word multiplier.
+ * @return Word The most significant word of the product.
+ */
+Word word_array_mul_1(Word* result, const Word* operand_x, size_t length, Word word)
+{
+    Word carry = 0;
+
+    for (size_t idx = 0; idx < length; idx++)
+    {
+        Word product_high, product_low;
+        word_multiplication_double(&product_high, &product_low, operand_x[idx], word);
+
+        product_low += carry;
+        result[idx] = product_low;
+        carry = product_high + (product_low < carry);
+    }
+
+    return carry;
+}
+
+/**
+ * @brief Adds the product of a word array and a single word to [result].
+ *
+ * This is one row of the textbook multiplication: r <- r + x * word.
+ *
+ * @param result [input/output] [length] words to accumulate into.
+ * @param operand_x [input] Word array operand.
+ * @param length [input] Number of words of [operand_x] and [result].
+ * @param word [input] Word multiplier.
+ * @return Word The word carried out of [result].
+ */
+Word word_array_addmul_1(Word* result, const Word* operand_x, size_t length, Word word)
+{
+    Word carry = 0;
+
+    for (size_t idx = 0; idx < length; idx++)
+    {
+        Word product_high, product_low;
+        word_multiplication_double(&product_high, &product_low, operand_x[idx], word);
+
+        product_low += carry;
+        product_high += (product_low < carry);
+        product_low += result[idx];
+        product_high += (product_low < result[idx]);
+
+        result[idx] = product_low;
+        carry = product_high;
+    }
+
+    return carry;
+}
+
+/**
+ * @brief Subtracts the product of a word array and a single word from [result].
+ *
+ * r <- r - x * word. This is the correction step of the long division.
+ *
+ * @param result [input/output] [length] words to subtract from.
+ * @param operand_x [input] Word array operand.
+ * @param length [input] Number of words of [operand_x] and [result].
+ * @param word [input] Word multiplier.
+ * @return Word The word borrowed out of [result].
+ */
+Word word_array_submul_1(Word* result, const Word* operand_x, size_t length, Word word)
+{
+    Word borrow = 0;
+
+    for (size_t idx = 0; idx < length; idx++)
+    {
+        Word product_high, product_low;
+        word_multiplication_double(&product_high, &product_low, operand_x[idx], word);
+
+        product_low += borrow;
+        product_high += (product_low < borrow);
+
+        Word difference = result[idx] - product_low;
+        product_high += (result[idx] < product_low);
+
+        result[idx] = difference;
+        borrow = product_high;
+    }
+
+    return borrow;
+}
+
+/**
+ * @brief Divides a word array by a single odd word when the division is exact.
+ *
+ * No division instruction is used: each quotient word is the current word times
+ * the inverse of [divisor] modulo W, and the high word of quotient * divisor is
+ * borrowed from the next word (Hensel division from the least significant word).
+ * Toom-Cook interpolation uses this to divide by 3 and 5.
+ *
+ * [operand] must be a multiple of [divisor], otherwise the result is meaningless.
+ *
+ * @param result [output] [length] words of operand / divisor.
+ * @param operand [input] Word array operand.
+ * @param length [input] Number of words of [operand].
+ * @param divisor [input] Odd word divisor.
+ */
+void word_array_divexact_1(Word* result, const Word* operand, size_t length, Word divisor)
+{
+    /* Inverse modulo W by Newton iteration: each step doubles the number of correct bits (3 at first) */
+    Word inverse = divisor;
+    for (size_t bits = 3; bits < BITLEN_OF_WORD; bits *= 2)
+        inverse *= (Word)(2 - divisor * inverse);
+
+    Word borrow = 0;
+
+    for (size_t idx = 0; idx < length; idx++)
+    {
+        Word word = operand[idx];
+        Word borrow_next = (word < borrow);
+        Word quotient = (Word)((Word)(word - borrow) * inverse);
+        Word product_high, product_low;
+
+        word_multiplication_double(&product_high, &product_low, quotient, divisor);
+
+        result[idx] = quotient;
+        borrow = product_high + borrow_next;
+    }
+}
+
+/**
+ * @brief Divides a word array by a single word in one pass from the most significant word.
+ *
+ * The divisor is normalized once, and the bits of [operand] are shifted on the fly,
+ * so each word costs one word_division_double_preinv and no division instruction.
+ *
+ * [quotient] may be NULL if only the remainder is needed, or [operand] itself.
+ *
+ * @param quotient [output] [length] words of operand / divisor, or NULL.
+ * @param operand [input] Word array operand.
+ * @param length [input] Number of words of [operand].
+ * @param divisor [input] Non-zero word divisor.
+ * @return Word operand mod divisor.
+ */
+Word word_array_divrem_1(Word* quotient, const Word* operand, size_t length, Word divisor)
+{
+    if (length == 0)
+        return 0;
+
+    /* Shift amount that sets the most significant bit of the divisor */
+    unsigned int shift = 0;
+    while (((Word)(divisor << shift) >> (BITLEN_OF_WORD - 1)) == 0)
+        shift++;
+
+    Word divisor_normalized = (Word)(divisor << shift);
+    Word reciprocal = word_reciprocal(divisor_normalized);
+
+    /* The bits shifted out of the top word start the remainder, so it is less than the divisor */
+    Word remainder = (shift == 0) ? 0 : (Word)(operand[length - 1] >> (BITLEN_OF_WORD - shift));
+
+    for (size_t idx = length; idx-- > 0;)
+    {
+        Word word = (Word)(operand[idx] << shift);
+        if (shift != 0 && idx > 0)
+            word |= (Word)(operand[idx - 1] >> (BITLEN_OF_WORD - shift));
+
+        /* operand[idx] is read before quotient[idx] is written, so they may be the same word */
+        Word quotient_word = word_division_double_preinv(&remainder, remainder, word, divisor_normalized, reciprocal);
+        if (quotient != NULL)
+            quotient[idx] = quotient_word;
+    }
+
+    return remainder >> shift;
+}
+
+/**
+ * @brief Multiplies two word arrays with the operand-scanning textbook algorithm.
+ *
+ * The first row x * y_0 is written with mul_1 and every following row
+ * x * y_j is accumulated into result[j..] with a single addmul_1 carry chain.
+ * The carry word out of each row becomes the next word of the result,
+ * so the product needs no allocation and exactly length_x * length_y word products.
+ *
+ *                          x_n-1 ... x_1 x_0
+ *                        * y_m-1 ... y_1 y_0
+ *     ---------------------------------------------------------
+ *                    [      x * y_0      ]      -- mul_1
+ *                [      x * y_1      ]          -- addmul_1
+ *                     ...
+ *     [      x * y_m-1      ]                   -- addmul_1
+ *
+ * [result] must have room for [length_x] + [length_y] words and must not overlap the operands.
+ *
+ * @param result [output] Product of the operands.
+ * @param operand_x [input] First operand.
+ * @param length_x [input] Number of words of [operand_x] (at least 1).
+ * @param operand_y [input] Second operand.
+ * @param length_y [input] Number of words of [operand_y] (at least 1).
+ */
+void word_array_mul_basecase(Word* result, const Word* operand_x, size_t length_x, const Word* operand_y, size_t length_y)
+{
+    result[length_x] = word_array_mul_1(result, operand_x, length_x, operand_y[0]);
+
+    for (size_t idx_y = 1; idx_y < length_y; idx_y++)
+        result[length_x + idx_y] = word_array_addmul_1(result + idx_y, operand_x, length_x, operand_y[idx_y]);
+}
+
+/**
+ * @brief Multiplies two word arrays with the product-scanning (Comba) algorithm.
+ *
+ * All word products x_i * y_(k-i) of the output column k are summed into a
+ * three-word accumulator (acc2 || acc1 || acc0). Then acc0 is written as the
+ * k-th word of the result and the accumulator is shifted down by one word.
+ * Every result word is written exactly once and carries stay in registers.
+ *
+ *     column k :  sum of x_i * y_(k-i)  for  max(0, k-m+1) <= i <= min(k, n-1)
+ *
+ * A column holds as many products as the shorter operand has words. The accumulator
+ * takes at most COMBA_COLUMN_MAX of them, so longer operands go to word_array_mul_basecase.
+ *
+ * [result] must have room for [length_x] + [length_y] words and must not overlap the operands.
+ *
+ * @param result [output] Product of the operands.
+ * @param operand_x [input] First operand.
+ * @param length_x [input] Number of words of [operand_x] (at least 1).
+ * @param operand_y [input] Second operand.
+ * @param length_y [input] Number of words of [operand_y] (at least 1).
+ */
+void word_array_mul_comba(Word* result, const Word* operand_x, size_t length_x, const Word* operand_y, size_t length_y)
+{
+    if (length_x > COMBA_COLUMN_MAX && length_y > COMBA_COLUMN_MAX) {
+        word_array_mul_basecase(result, operand_x, length_x, operand_y, length_y);
+        return;
+    }
+
+    Word acc0 = 0, acc1 = 0, acc2 = 0; // three-word accumulator
+    size_t column_num = length_x + length_y - 1;
+
+    for (size_t column = 0; column < column_num; column++)
+    {
+        size_t idx_start = (column < length_y) ? 0 : column - length_y + 1;
+        size_t idx_end = (column < length_x) ? column : length_x - 1;
+
+        for (size_t idx_x = idx_start; idx_x <= idx_end; idx_x++)
+        {
+            Word product_high, product_low;
+            word_multiplication_double(&product_high, &product_low, operand_x[idx_x], operand_y[column - idx_x]);
+
+            acc0 += product_low;
+            product_high += (acc0 < product_low); // cannot overflow: product_high <= W - 2
+            acc1 += product_high;
+            acc2 += (acc1 < product_high);
+        }
+
+        /* Write the column and shift the accumulator */
+        result[column] = acc0;
+        acc0 = acc1;
+        acc1 = acc2;
+        acc2 = 0;
+    }
+
+    result[column_num] = acc0;
+}
+
+/**
+ * @brief Squares a word array.
+ *
+ * Every cross product x_i * x_j (i < j) appears twice in the square, so it is
+ * computed once with the row-based method, the sum is doubled with a one-bit
+ * shift, and the diagonal squares x_i^2 are added last. This takes about
+ * half of the word products of word_array_mul_basecase.
+ *
+ *     x^2 = 2 * sum_(i<j) x_i * x_j * W^(i+j)  +  sum_i x_i^2 * W^(2i)
+ *
+ * [result] must have room for 2 * [length] words and must not overlap the operand.
+ *
+ * @param result [output] Square of the operand.
+ * @param operand [input] Operand.
+ * @param length [input] Number of words of [operand] (at least 1).
+ */
+void word_array_sqr_basecase(Word* result, const Word* operand, size_t length)
+{
+    /* Cross products: row i is x_i * (x_(i+1) ... x_(n-1)) at result[2i+1] */
+    result[0] = 0;
+    result[2 * length - 1] = 0;
+
+    if (length > 1)
+    {
+        result[length] = word_array_mul_1(result + 1, operand + 1, length - 1, operand[0]);
+
+        for (size_t idx = 1; idx < length - 1; idx++)
+            result[length + idx] = word_array_addmul_1(result + 2 * idx + 1, operand + idx + 1, length - idx - 1, operand[idx]);
+    }
+
+    /* Double the cross products: no bit is shifted out since the sum is less than W^(2n-1) */
+    word_array_shift_left(result, result, 2 * length, 1);
+
+    /* Add the diagonal squares */
+    Word carry = 0;
+
+    for (size_t idx = 0; idx < length; idx++)
+    {
+        Word square_high, square_low;
+        word_multiplication_double(&square_high, &square_low, operand[idx], operand[idx]);
+
+        carry = word_addition_with_carry(&result[2 * idx],     carry, result[2 * idx],     square_low);
+        carry = word_addition_with_carry(&result[2 * idx + 1], carry, result[2 * idx + 1], square_high);
+    }
+}
+
+/**
+ * @brief Shifts a word array to the left by less than one word.
+ *
+ * @param result [output] [length] words of operand << bit_count.
+ * @param operand [input] Word array operand.
+ * @param length [input] Number of words of [operand].
+ * @param bit_count [input] Shift amount (0 <= bit_count < BITLEN_OF_WORD).
+ * @return Word The bits shifted out of the most significant word.
+ */
+Word word_array_shift_left(Word* result, const Word* operand, size_t length, unsigned int bit_count)
+{
+    if (bit_count == 0) {
+        memmove(result, operand, length * SIZE_OF_WORD);
+        return 0;
+    }
+
+    Word carry = 0;
+
+    for (size_t idx = 0; idx < length; idx++)
+    {
+        Word word = operand[idx];
+        result[idx] = (word << bit_count) | carry;
+        carry = word >> (BITLEN_OF_WORD - bit_count);
+    }
+
+    return carry;
+}
+
+/**
+ * @brief Shifts a word array to the right by less than one word.
+ *
+ * @param result [output] [length] words of operand >> bit_count.
+ * @param operand [input] Word array operand.
+ * @param length [input] Number of words of [operand].
+ * @param bit_count [input] Shift amount (0 <= bit_count < BITLEN_OF_WORD).
+ * @return Word The bits shifted out of the least significant word, kept in the upper bits.
+ */
+Word word_array_shift_right(Word* result, const Word* operand, size_t length, unsigned int bit_count)
+{
+    if (bit_count == 0) {
+        memmove(result, operand, length * SIZE_OF_WORD);
+        return 0;
+    }
+
+    Word carry = 0;
+
+    while (length--)
+    {
+        Word word = operand[length];
+        result[length] = (word >> bit_count) | carry;
+        carry = word << (BITLEN_OF_WORD - bit_count);
+    }
+
+    return carry;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file autobahn_kernel.h
+ * @brief Low-level Word Array Kernels for Autobahn Project.
+ *
+ * This header file declares the internal kernels that the Bigint operations
+ * are built on. A kernel works on plain Word arrays (least significant word
+ * first) whose memory is owned by the caller, and it never allocates memory.
+ * Instead of growing its output, a kernel returns the carry or borrow out of
+ * the most significant word, so the caller decides how large the buffers are.
+ *
+ * Unless noted otherwise, [result] may be the same array as [operand_x],
+ * but it must not partially overlap any of the operands.
+ *
+ * @version 0.1
+ * @date 2023-12-16
+ *
+ * @note
+ * These functions are internal to the library. Users should call the Bigint
+ * functions declared in autobahn.h.
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef AUTOBAHN_KERNEL_H
+#define AUTOBAHN_KERNEL_H
+
+#include "autobahn_common.h"
+
+#if !defined(DOUBLE_WORD_AVAILABLE) && defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Multiplies two words into a double-word product.
+ *
+ * The product is computed with the native double-width multiplication when
+ * the compiler offers one: a uint64_t widening for 32-bit words, and
+ * unsigned __int128 (one MUL instruction on x86-64) or _umul128 for 64-bit words.
+ * Since the function is inlined, both halves stay in registers.
+ *
+ * Otherwise, each operand is split into half words and four partial products are computed.
+ *
+ *                      x_high || x_low     -- operand_x : word
+ *                      y_high || y_low     -- operand_y : word
+ *     ---------------------------------------------------------
+ *                      [x_low * y_low]     -- mid2
+ *              [x_high * y_low]            -- mid0
+ *              [x_low * y_high]            -- mid1
+ *      [x_high * y_high]                   -- mid3
+ *     ---------------------------------------------------------
+ *      [ result_high ]  [ result_low ]
+ *
+ * @param result_high [output] Upper word of the product.
+ * @param result_low [output] Lower word of the product.
+ * @param operand_x [input] First word for multiplication.
+ * @param operand_y [input] Second word for multiplication.
+ */
+static inline void word_multiplication_double(Word* result_high, Word* result_low, Word operand_x, Word operand_y)
+{
+#if defined(DOUBLE_WORD_AVAILABLE)
+    DoubleWord product = (DoubleWord)operand_x * operand_y;
+
+    *result_low  = (Word)product;
+    *result_high = (Word)(product >> BITLEN_OF_WORD);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned __int64 product_high;
+
+    *result_low  = _umul128(operand_x, operand_y, &product_high);
+    *result_high = product_high;
+#else
+    Word bitlen_half = BITLEN_OF_WORD / 2;
+    Word x_high = operand_x >> bitlen_half;            // Upper half of operand_x
+    Word x_low  = (x_high << bitlen_half) ^ operand_x; // Lower half of operand_x
+    Word y_high = operand_y >> bitlen_half;            // Upper half of operand_y
+    Word y_low  = (y_high << bitlen_half) ^ operand_y; // Lower half of operand_y
+
+    Word mid0 = x_high * y_low;
+    Word mid1 = x_low * y_high;
+    Word mid2 = x_low * y_low;
+    Word mid3 = x_high * y_high;
+    Word middle = mid0 + mid1;
+
+    *result_low  = mid2 + (middle << bitlen_half);
+    *result_high = mid3 + (middle >> bitlen_half) + ((Word)(middle < mid0) << bitlen_half) + (*result_low < mid2);
+#endif
+}
+
+/**
+ * @brief Divides a two-word number by a word: (high*W + low) = divisor*quotient + remainder.
+ *
+ * The hardware division of x86-64 gives the quotient and the remainder at once.
+ * Elsewhere DoubleWord (or _udiv128) is used, and the bit-serial long division is
+ * the last resort. [dividend_high] must be less than [divisor], so the quotient fits in a word.
+ *
+ * @param remainder [output] Remainder of the division.
+ * @return Word Quotient of the division.
+ */
+static inline Word word_division_double(Word* remainder, Word dividend_high, Word dividend_low, Word divisor)
+{
+#if defined(BI_WORD64) && defined(__GNUC__) && defined(__x86_64__)
+    Word quotient;
+
+    __asm__("divq %4" : "=a"(quotient), "=d"(*remainder) : "a"(dividend_low), "d"(dividend_high), "rm"(divisor));
+    return quotient;
+#elif defined(DOUBLE_WORD_AVAILABLE)
+    DoubleWord dividend = ((DoubleWord)dividend_high << BITLEN_OF_WORD) | dividend_low;
+
+    *remainder = (Word)(dividend % divisor);
+    return (Word)(dividend / divisor);
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+    return _udiv128(dividend_high, dividend_low, divisor, remainder);
+#else
+    /* Shift in one bit of dividend_low at a time; partial_remainder < divisor all the time */
+    Word quotient = 0;
+    Word partial_remainder = dividend_high;
+
+    for (size_t bit_idx = BITLEN_OF_WORD; bit_idx-- > 0;)
+    {
+        Word carry = partial_remainder >> (BITLEN_OF_WORD - 1);
+
+        partial_remainder = (partial_remainder << 1) | ((dividend_low >> bit_idx) & 1);
+        quotient <<= 1;
+
+        if (carry || partial_remainder >= divisor) {
+            partial_remainder -= divisor;
+            quotient |= 1;
+        }
+    }
+
+    *remainder = partial_remainder;
+    return quotient;
+#endif
+}
+
+/**
+ * @brief Computes the reciprocal of a normalized word for word_division_double_preinv.
+ *
+ * The reciprocal is floor((W^2 - 1) / divisor) - W (Moller-Granlund).
+ *
+ * @param divisor [input] Word whose most significant bit is set.
+ */
+static inline Word word_reciprocal(Word divisor)
+{
+    Word remainder;
+    return word_division_double(&remainder, (Word)~divisor, (Word)~(Word)0, divisor);
+}
+
+/**
+ * @brief Divides a two-word number by a normalized word with its precomputed reciprocal.
+ *
+ * The quotient is estimated with one multiplication by [reciprocal] and corrected
+ * at most twice, so no division instruction is used (Moller-Granlund, Algorithm 4).
+ * This is faster than word_division_double when the same divisor is used many times.
+ * [dividend_high] must be less than [divisor].
+ *
+ * @param remainder [output] Remainder of the division.
+ * @param reciprocal [input] word_reciprocal(divisor).
+ * @return Word Quotient of the division.
+ */
+static inline Word word_division_double_preinv(Word* remainder, Word dividend_high, Word dividend_low, Word divisor, Word reciprocal)
+{
+    Word quotient, quotient_low;
+
+    /* (quotient, quotient_low) = reciprocal * high + (high + 1)*W + low */
+    word_multiplication_double(&quotient, &quotient_low, reciprocal, dividend_high);
+    quotient_low += dividend_low;
+    quotient += dividend_high + 1 + (quotient_low < dividend_low);
+
+    Word partial_remainder = dividend_low - quotient * divisor;
+
+    if (partial_remainder > quotient_low) {
+        quotient--;
+        partial_remainder += divisor;
+    }
+    if (partial_remainder >= divisor) {
+        quotient++;
+        partial_remainder -= divisor;
+    }
+
+    *remainder = partial_remainder;
+    return quotient;
+}
+
+/* Comparison and normalization */
+int word_array_compare(const Word* operand_x, const Word* operand_y, size_t length);
+size_t word_array_refined_length(const Word* operand, size_t length);
+
+/* Addition and Subtraction */
+Word word_array_add_n(Word* result, const Word* operand_x, const Word* operand_y, size_t length);
+Word word_array_add_1(Word* result, const Word* operand_x, size_t length, Word word);
+Word word_array_add(Word* result, const Word* operand_x, size_t length_x, const Word* operand_y, size_t length_y);
+Word word_array_sub_n(Word* result, const Word* operand_x, const Word* operand_y, size_t length);
+Word word_array_sub_1(Word* result, const Word* operand_x, size_t length, Word word);
+Word word_array_sub(Word* result, const Word* operand_x, size_t length_x, const Word* operand_y, size_t length_y);
+
+/* Multiplication by a single word */
+Word word_array_mul_1(Word* result, const Word* operand_x, size_t length, Word word);
+Word word_array_addmul_1(Word* result, const Word* operand_x, size_t length, Word word);
+Word word_array_submul_1(Word* result, const Word* operand_x, size_t length, Word word);
+void word_array_divexact_1(Word* result, const Word* operand, size_t length, Word divisor);
+Word word_array_divrem_1(Word* quotient, const Word* operand, size_t length, Word divisor);
+
+/* Multiplication */
+void word_array_mul_basecase(Word* result, const Word* operand_x, size_t length_x, const Word* operand_y, size_t length_y);
+void word_array_mul_comba(Word* result, const Word* operand_x, size_t length_x, const Word* operand_y, size_t length_y);
+void word_array_sqr_basecase(Word* result, const Word* operand, size_t length);
+
+/* Shift by less than one word */
+Word word_array_shift_left(Word* result, const Word* operand, size_t length, unsigned int bit_count);
+Word word_array_shift_right(Word* result, const Word* operand, size_t length, unsigned int bit_count);
+
+#endif
@@ -1,60 +1,199 @@
 #include "autobahn.h"
+#include "autobahn_kernel.h"
 
-void debug_print(const Bigint* bigint)
+// Default thresholds of bigint_multiplication, bigint_squaring and bigint_division (see Thresholds).
+// With BI_TUNED_THRESHOLDS, they come from autobahn_thresholds.h, written by the tuner in tune/.
+#if defined(BI_TUNED_THRESHOLDS)
+    #include "autobahn_thresholds.h"
+#else
+    #define COMBA_THRESHOLD 8
+    #define KARATSUBA_THRESHOLD 80
+    #define TOOM3_THRESHOLD 160
+    #define TOOM4_THRESHOLD 384
+    #define NTT_THRESHOLD 12288
+    #define UNBALANCED_RATIO 4
+    #define SQUARING_KARATSUBA_THRESHOLD 32
+    #define SQUARING_TOOM3_THRESHOLD 320
+    #define SQUARING_TOOM4_THRESHOLD 768
+    #define SQUARING_NTT_THRESHOLD 16384
+    #define BURNIKEL_ZIEGLER_THRESHOLD 40
+    #define NEWTON_THRESHOLD 262144
+#endif
+#define THRESHOLDS_DEFAULT { \
+    COMBA_THRESHOLD, KARATSUBA_THRESHOLD, TOOM3_THRESHOLD, TOOM4_THRESHOLD, NTT_THRESHOLD, UNBALANCED_RATIO, \
+    SQUARING_KARATSUBA_THRESHOLD, SQUARING_TOOM3_THRESHOLD, SQUARING_TOOM4_THRESHOLD, SQUARING_NTT_THRESHOLD, \
+    BURNIKEL_ZIEGLER_THRESHOLD, NEWTON_THRESHOLD }
+
+#define TOOM_THRESHOLD_MIN 16            ///< Toom-Cook thresholds are at least this, so the pointwise products are shorter than the operands.
+#define UNBALANCED_RATIO_MIN 2           ///< The chunks of bigint_multiplication_unbalanced must be balanced products.
+#define BURNIKEL_ZIEGLER_THRESHOLD_MIN 2 ///< Burnikel-Ziegler splits the divisor in two nonempty halves.
+#define NEWTON_THRESHOLD_MIN 4           ///< The recursion of the reciprocal only halves precisions of 3 words or more.
+#define TOOM_POINT_MAX 7                 ///< Largest number of evaluation points of Toom-Cook.
+#define NTT_CHUNK_BITLEN 32              ///< The NTT cuts operands into coefficients of this many bits.
+#define NTT_LENGTH_MAX (3 * ((size_t)1 << 25)) ///< Longest transform supported by all primes of the NTT.
+#define NTT_DIGIT_NUM_MAX (NTT_LENGTH_MAX / BITLEN_OF_WORD * NTT_CHUNK_BITLEN) ///< Largest total number of digits of the operands of the NTT.
+
+/**
+ * @brief Thresholds in use by bigint_multiplication, bigint_squaring and bigint_division.
+ */
+static Thresholds thresholds_in_use = THRESHOLDS_DEFAULT;
+
+/**
+ * @brief Gets the thresholds in use by bigint_multiplication, bigint_squaring and bigint_division.
+ * 
+ * @param thresholds [output] Copy of the thresholds.
+ */
+void bigint_get_thresholds(Thresholds* thresholds)
 {
-    for(int i = bigint->digit_num - 1; i >= 0; i--) printf("%02x ", bigint->digits[i]);
-    printf("\n");
+    *thresholds = thresholds_in_use;
 }
 
 /**
- * @brief Performs multiplication of two words using the schoolbook multiplication algorithm.
+ * @brief Sets the thresholds of bigint_multiplication, bigint_squaring and bigint_division.
  * 
- * This function multiplies the values of [operand_x] and [operand_y] using the schoolbook multiplication
- * algorithm and stores the result in [result]. The algorithm is explained in the ASCII art above the function.
+ * Every multiplication in the library goes through bigint_multiplication, so this tunes
+ * all of them. Values that would let the recursion loop are raised: Toom-Cook thresholds
+ * to TOOM_THRESHOLD_MIN, the ratio of unbalanced multiplication to UNBALANCED_RATIO_MIN
+ * and the division thresholds to BURNIKEL_ZIEGLER_THRESHOLD_MIN and NEWTON_THRESHOLD_MIN.
+ * Set the thresholds before starting threads that multiply; they are not synchronized.
+ * 
+ * @param thresholds [input] New thresholds, or NULL to restore the defaults.
+ */
+void bigint_set_thresholds(const Thresholds* thresholds)
+{
+    if (thresholds == NULL) {
+        Thresholds defaults = THRESHOLDS_DEFAULT;
+        thresholds_in_use = defaults;
+        return;
+    }
+
+    thresholds_in_use = *thresholds;
+
+    size_t* toom_thresholds[] = {
+        &thresholds_in_use.toom3, &thresholds_in_use.toom4,
+        &thresholds_in_use.squaring_toom3, &thresholds_in_use.squaring_toom4
+    };
+    for (size_t idx = 0; idx < sizeof(toom_thresholds) / sizeof(toom_thresholds[0]); idx++) {
+        if (*toom_thresholds[idx] < TOOM_THRESHOLD_MIN)
+            *toom_thresholds[idx] = TOOM_THRESHOLD_MIN;
+    }
+    if (thresholds_in_use.unbalanced_ratio < UNBALANCED_RATIO_MIN)
+        thresholds_in_use.unbalanced_ratio = UNBALANCED_RATIO_MIN;
+    if (thresholds_in_use.burnikel_ziegler < BURNIKEL_ZIEGLER_THRESHOLD_MIN)
+        thresholds_in_use.burnikel_ziegler = BURNIKEL_ZIEGLER_THRESHOLD_MIN;
+    if (thresholds_in_use.newton < NEWTON_THRESHOLD_MIN)
+        thresholds_in_use.newton = NEWTON_THRESHOLD_MIN;
+}
+
+/**
+ * @brief Names of the thresholds in files, in the order of Thresholds.
+ */
+static const struct {
+    const char* name;
+    size_t offset;
+} threshold_fields[] = {
+    { "comba",              offsetof(Thresholds, comba) },
+    { "karatsuba",          offsetof(Thresholds, karatsuba) },
+    { "toom3",              offsetof(Thresholds, toom3) },
+    { "toom4",              offsetof(Thresholds, toom4) },
+    { "ntt",                offsetof(Thresholds, ntt) },
+    { "unbalanced_ratio",   offsetof(Thresholds, unbalanced_ratio) },
+    { "squaring_karatsuba", offsetof(Thresholds, squaring_karatsuba) },
+    { "squaring_toom3",     offsetof(Thresholds, squaring_toom3) },
+    { "squaring_toom4",     offsetof(Thresholds, squaring_toom4) },
+    { "squaring_ntt",       offsetof(Thresholds, squaring_ntt) },
+    { "burnikel_ziegler",   offsetof(Thresholds, burnikel_ziegler) },
+    { "newton",             offsetof(Thresholds, newton) },
+};
+
+#define THRESHOLD_FIELD_NUM (sizeof(threshold_fields) / sizeof(threshold_fields[0]))
+#define THRESHOLD_FIELD(thresholds, idx) (*(size_t*)((char*)(thresholds) + threshold_fields[idx].offset))
+
+/**
+ * @brief Writes the thresholds in use into a file that bigint_load_thresholds reads.
  * 
- *                      x_high || x_low     -- operand_x : word
- *                      y_high || y_low     -- operand_y : word
- *     ---------------------------------------------------------
- *                      [x_low * y_low]     -- mid0
- *              [x_high * y_low]            -- mid1           
- *              [y_high * x_low]            -- mid2    
- *      [x_high * y_high]                   -- mid3
- *     ---------------------------------------------------------
- *      [ result_high ]  [ result_low ]
- *             [ result_middle ]
+ * Each line is "<name> <value>", with the names of the fields of Thresholds,
+ * after a "word_bitlen" line, since the thresholds count digits of the current word size.
  * 
- * @param result [output] Pointer to the variable to store the result of the multiplication.
- * @param operand_x [input] First word for multiplicatㄴion.
- * @param operand_y [input] Second word for multiplication.
+ * @param file_path [input] Path of the file to write.
+ * @return char TRUE if the file was written, FALSE otherwise.
+ */
+char bigint_save_thresholds(const char* file_path)
+{
+    FILE* file = fopen(file_path, "w");
+
+    if (file == NULL) {
+        printf("cannot open %s\n", file_path);
+        return FALSE;
+    }
+
+    fprintf(file, "# autobahn thresholds, in digits\n");
+    fprintf(file, "word_bitlen %zu\n", (size_t)BITLEN_OF_WORD);
+    for (size_t idx = 0; idx < THRESHOLD_FIELD_NUM; idx++)
+        fprintf(file, "%s %zu\n", threshold_fields[idx].name, THRESHOLD_FIELD(&thresholds_in_use, idx));
+
+    fclose(file);
+    return TRUE;
+}
+
+/**
+ * @brief Loads thresholds from a file written by bigint_save_thresholds or the tuner.
+ * 
+ * Lines starting with '#' are comments, and thresholds missing from the file keep their
+ * current values. The values go through bigint_set_thresholds, so they are
+ * checked the same way. A file written for another word size is rejected.
+ * 
+ * @param file_path [input] Path of the file to read.
+ * @return char TRUE if the thresholds were loaded, FALSE otherwise (they are unchanged).
  */
-void word_multiplication(Bigint** result, const Word operand_x, const Word operand_y) 
+char bigint_load_thresholds(const char* file_path)
 {
-    /* Initialize variables */
-    Word bitlen_half = BITLEN_OF_WORD / 2;
-    Word x_high = operand_x >> bitlen_half;            // Upper half of operand_x
-    Word x_low  = (x_high << bitlen_half) ^ operand_x; // Lower half of operand_x
-    Word y_high = operand_y >> bitlen_half;            // Upper half of operand_y
-    Word y_low  = (y_high << bitlen_half) ^ operand_y; // Lower half of operand_y
+    FILE* file = fopen(file_path, "r");
+
+    if (file == NULL) {
+        printf("cannot open %s\n", file_path);
+        return FALSE;
+    }
+
+    Thresholds thresholds = thresholds_in_use;
+    char line[128];
+    char name[64];
+    size_t value;
 
-    /* Multiplication : read function comment for detail */
-    Word mid0 = x_high * y_low;
-    Word mid1 = x_low * y_high;
-    Word mid2 = x_low * y_low;
-    Word mid3 = x_high * y_high;
-    Word result_middle = mid0 + mid1;
-    Word result_low = mid2 + (result_middle << bitlen_half);
-    Word result_high = mid3 + (result_middle >> bitlen_half) + ((result_middle < mid0) << bitlen_half) + (result_low < mid2);
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] == '#' || sscanf(line, "%63s %zu", name, &value) != 2)
+            continue;
 
-    /* Store the result */
-    (*result)->digits[0] = result_low; // Store the lower half
-    (*result)->digits[1] = result_high; // Store the upper half
+        if (strcmp(name, "word_bitlen") == 0 && value != BITLEN_OF_WORD) {
+            printf("%s is for %zu-bit words\n", file_path, value);
+            fclose(file);
+            return FALSE;
+        }
+
+        for (size_t idx = 0; idx < THRESHOLD_FIELD_NUM; idx++) {
+            if (strcmp(name, threshold_fields[idx].name) == 0)
+                THRESHOLD_FIELD(&thresholds, idx) = value;
+        }
+    }
+
+    fclose(file);
+    bigint_set_thresholds(&thresholds);
+    return TRUE;
+}
+
+void debug_print(const Bigint* bigint)
+{
+    for(size_t i = bigint->digit_num; i-- > 0;) printf(PRINT_WORD_FIX_FORMAT " ", bigint->digits[i]);
+    printf("\n");
 }
 
 /**
  * @brief Performs multiplication of two large integers using the textbook algorithm.
  * 
  * This function multiplies the values of [operand_x] and [operand_y] using the textbook algorithm
- * and stores the result in [result].
+ * and stores the result in [result]. Each row x * y_j is added into one preallocated
+ * result buffer with a single carry chain, so the multiplication is O(n*m) without
+ * any allocation inside the loop.
  * 
  * @param result [output] Pointer to the variable to store the result of the multiplication.
  * @param operand_x [input] Pointer to the first large integer for multiplication.
@@ -67,35 +206,120 @@ void bigint_multiplication_textbook(Bigint** result, const Bigint* operand_x, co
         return;
     }
 
-    Bigint* tmp_result = NULL;
-    Bigint* word_mult = NULL; // result of word multiplication
-    Bigint* word_mult_expanded = NULL; // expanded result of word multiplication to set correct index
+    /* x * x is a squaring */
+    if (operand_x == operand_y) {
+        bigint_squaring_textbook(result, operand_x);
+        return;
+    }
+
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with an operand.
 
     /* Allocate */
-    bigint_new(&tmp_result, operand_x->digit_num + operand_y->digit_num);
-    bigint_new(&word_mult, 2);
-    bigint_new(&word_mult_expanded, 1);
+    Bigint** output = bigint_output_new(result, &tmp_result, operand_x->digit_num + operand_y->digit_num, operand_x, operand_y);
 
     /* Multiplication: O(n^2) */
-    for (Word idx_x = 0; idx_x < operand_x->digit_num; idx_x++) 
-    {
-        for (Word idx_y = 0; idx_y < operand_y->digit_num; idx_y++) 
-        {
-            word_multiplication(&word_mult, operand_x->digits[idx_x], operand_y->digits[idx_y]); // Multiplication
-            bigint_expand(&word_mult_expanded, word_mult, idx_x + idx_y); // set correct index
-            bigint_addition(&tmp_result, tmp_result, word_mult_expanded); // Addition to the result
-        }
+    word_array_mul_basecase((*output)->digits, operand_x->digits, operand_x->digit_num, operand_y->digits, operand_y->digit_num);
+
+    /* Get the result */
+    bigint_refine(*output);
+    (*output)->sign = (operand_x->sign == operand_y->sign) ? POSITIVE : NEGATIVE;
+    bigint_output_finish(result, &tmp_result);
+
+    /* Free */
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Performs multiplication of two large integers using the Comba algorithm.
+ * 
+ * This function multiplies the values of [operand_x] and [operand_y] column by column
+ * (product scanning) and stores the result in [result]. Each word of the result is
+ * written once from a three-word accumulator, which makes it faster than the
+ * textbook algorithm for the operand sizes used in cryptography.
+ * 
+ * @param result [output] Pointer to the variable to store the result of the multiplication.
+ * @param operand_x [input] Pointer to the first large integer for multiplication.
+ * @param operand_y [input] Pointer to the second large integer for multiplication.
+ */
+void bigint_multiplication_comba(Bigint** result, const Bigint* operand_x, const Bigint* operand_y) 
+{
+    if(bigint_is_zero(operand_x) || bigint_is_zero(operand_y)) {
+        bigint_set_zero(result);
+        return;
     }
 
+    /* x * x is a squaring */
+    if (operand_x == operand_y) {
+        bigint_squaring_textbook(result, operand_x);
+        return;
+    }
+
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with an operand.
+
+    /* Allocate */
+    Bigint** output = bigint_output_new(result, &tmp_result, operand_x->digit_num + operand_y->digit_num, operand_x, operand_y);
+
+    /* Multiplication: O(n^2) */
+    word_array_mul_comba((*output)->digits, operand_x->digits, operand_x->digit_num, operand_y->digits, operand_y->digit_num);
+
     /* Get the result */
-    bigint_refine(tmp_result);
-    tmp_result->sign = (operand_x->sign == operand_y->sign) ? POSITIVE : NEGATIVE;
-    bigint_copy(result, tmp_result);
+    bigint_refine(*output);
+    (*output)->sign = (operand_x->sign == operand_y->sign) ? POSITIVE : NEGATIVE;
+    bigint_output_finish(result, &tmp_result);
 
     /* Free */
-    bigint_delete(&tmp_result);
-    bigint_delete(&word_mult);
-    bigint_delete(&word_mult_expanded);
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Multiplies a large integer by a single word.
+ * 
+ * [result] <- [bigint] * [word] with one mul_1 pass over the digits.
+ * [result] may be the same object as [bigint].
+ * 
+ * @param result [output] Result of the multiplication.
+ * @param bigint [input] Large integer operand.
+ * @param word [input] Word multiplier.
+ */
+void bigint_multiplication_word(Bigint** result, const Bigint* bigint, Word word)
+{
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with [bigint].
+
+    /* Allocate */
+    Bigint** output = bigint_output_new(result, &tmp_result, bigint->digit_num + 1, bigint, NULL);
+
+    /* Multiplication: O(n) */
+    (*output)->digits[bigint->digit_num] = word_array_mul_1((*output)->digits, bigint->digits, bigint->digit_num, word);
+
+    /* Get the result: zero is made positive by refine */
+    (*output)->sign = bigint->sign;
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
+
+    /* Free */
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Multiplies a large integer by a single word in place.
+ * 
+ * [bigint] <- [bigint] * [word], without allocating a new result.
+ * [bigint] grows by one digit only if its capacity is not large enough.
+ * 
+ * @param bigint [input/output] Memory address of the large integer to update.
+ * @param word [input] Word multiplier.
+ */
+void bigint_multiplication_word_inplace(Bigint** bigint, Word word)
+{
+    size_t digit_num = (*bigint)->digit_num;
+
+    bigint_resize(bigint, digit_num + 1);
+    (*bigint)->digits[digit_num] = word_array_mul_1((*bigint)->digits, (*bigint)->digits, digit_num, word);
+
+    bigint_refine(*bigint);
 }
 
 void bigint_multiplication_karatsuba(Bigint** result, const Bigint* operand_x, const Bigint* operand_y) 
@@ -105,96 +329,1206 @@ void bigint_multiplication_karatsuba(Bigint** result, const Bigint* operand_x, c
         return;
     }
 
-    Word digit_num_min = operand_x->digit_num < operand_y->digit_num ? operand_x->digit_num : operand_y->digit_num;
-	Word digit_num_max = operand_x->digit_num > operand_y->digit_num ? operand_x->digit_num : operand_y->digit_num;
-	Word digit_num_half = (digit_num_max + 1) >> 1;
+    size_t digit_num_min = operand_x->digit_num < operand_y->digit_num ? operand_x->digit_num : operand_y->digit_num;
+	size_t digit_num_max = operand_x->digit_num > operand_y->digit_num ? operand_x->digit_num : operand_y->digit_num;
+	size_t digit_num_half = (digit_num_max + 1) >> 1;
     
     // if (operand_x->digit_num == 1 || operand_y->digit_num == 1) {
     //     bigint_multiplication_textbook(result, operand_x, operand_y);
     //     return;
     // }
 
-    /* Recursion stop flag */
+    /* x * x is a squaring */
+    if (operand_x == operand_y) {
+        bigint_squaring_karatsuba(result, operand_x);
+        return;
+    }
+
+    /* Too short to split: the halves go through bigint_multiplication, so this only stops direct calls */
     if (digit_num_min <= 2) {
-        bigint_multiplication_textbook(result, operand_x, operand_y);
+        bigint_multiplication_comba(result, operand_x, operand_y);
+        return;
+    }
+
+    /* The shorter operand would lie in the lower half only: split the longer one instead of padding */
+    if (digit_num_min <= digit_num_half) {
+        bigint_multiplication_unbalanced(result, operand_x, operand_y);
         return;
     }
 
-	Bigint *x_low = NULL;
-    Bigint *x_high = NULL;
-    Bigint *y_low = NULL;
-    Bigint *y_high = NULL;
+    /* divide operands to upper and lower: views cost no copy, and a missing upper part is zero */
+    Bigint x_low  = bigint_view_part(operand_x, 0, digit_num_half);
+    Bigint x_high = bigint_view_part(operand_x, digit_num_half, digit_num_half * 2);
+    Bigint y_low  = bigint_view_part(operand_y, 0, digit_num_half);
+    Bigint y_high = bigint_view_part(operand_y, digit_num_half, digit_num_half * 2);
+
     Bigint *y_lowhigh = NULL;
     Bigint *x_lowhigh = NULL;
     Bigint *result_low = NULL;
     Bigint *result_high = NULL;
     Bigint *result_middle = NULL;
     Bigint *tmp_result = NULL;
-    Bigint* tmp_x = NULL;
-    Bigint* tmp_y = NULL;
-
-	bigint_new(&x_low, 1);
-	bigint_new(&x_high, 1);
-	bigint_new(&y_low, 1);
-	bigint_new(&y_high, 1);
-	bigint_new(&y_lowhigh, 1);
-	bigint_new(&x_lowhigh, 1);
-	bigint_new(&result_low, 1);
-	bigint_new(&result_high, 1);
-	bigint_new(&result_middle, 1);
-    bigint_new(&tmp_x, 1);
-    bigint_new(&tmp_y, 1);
-	bigint_new(&tmp_result, 1);
-
-    bigint_copy(&tmp_x, operand_x);
-    bigint_copy(&tmp_y, operand_y);
-
-    /* Make operands have the same number of digits */
-    tmp_x->digits = (Word*)realloc(tmp_x->digits, digit_num_half * 2 * SIZE_OF_WORD);
-    tmp_x->digit_num = digit_num_half * 2;
-    tmp_y->digits = (Word*)realloc(tmp_y->digits, digit_num_half * 2 * SIZE_OF_WORD);
-    tmp_y->digit_num = digit_num_half * 2;
-	
-    /* divide operand to upper and lower */
-    bigint_copy_part(&x_low, tmp_x, 0, digit_num_half);
-    bigint_copy_part(&y_low, tmp_y, 0, digit_num_half);
-    bigint_copy_part(&x_high, tmp_x, digit_num_half, digit_num_half * 2);
-    bigint_copy_part(&y_high, tmp_y, digit_num_half, digit_num_half * 2);
+
+    /* Allocate temporaries with their final sizes, so none of them leaves the scratch arena */
+    ScratchMark mark = bigint_scratch_mark();
+	bigint_scratch_new(&y_lowhigh, digit_num_half);
+	bigint_scratch_new(&x_lowhigh, digit_num_half);
+	bigint_scratch_new(&result_low, digit_num_half * 2);
+	bigint_scratch_new(&result_high, digit_num_half * 2);
+	bigint_scratch_new(&result_middle, digit_num_half * 2 + 2);
 
     /* compute high value and low value */
-	bigint_multiplication_karatsuba(&result_high, x_high, y_high);
-	bigint_multiplication_karatsuba(&result_low, x_low, y_low);
-
-    /* compute middle value */
-	bigint_subtraction(&x_lowhigh, x_high, x_low);
-	bigint_subtraction(&y_lowhigh, y_low, y_high);
-	bigint_multiplication_karatsuba(&result_middle, x_lowhigh, y_lowhigh);
-    //result_middle->sign = x_lowhigh->sign ^ y_lowhigh->sign;
-	bigint_addition(&result_middle, result_middle, result_high);
-	bigint_addition(&result_middle, result_middle, result_low);
-
-    /* compute result */
-    bigint_expand(&result_high, result_high, digit_num_half * 2);
-	bigint_expand(&result_middle, result_middle, digit_num_half);
-	bigint_addition(&tmp_result, result_high, result_low);
-	bigint_addition(&tmp_result, tmp_result, result_middle);
+	bigint_multiplication(&result_high, &x_high, &y_high);
+	bigint_multiplication(&result_low, &x_low, &y_low);
+
+    /* compute middle value: (x1 - x0)(y0 - y1) + x1 * y1 + x0 * y0 = x1 * y0 + x0 * y1, never negative */
+	bigint_subtraction(&x_lowhigh, &x_high, &x_low);
+	bigint_subtraction(&y_lowhigh, &y_low, &y_high);
+	bigint_multiplication(&result_middle, x_lowhigh, y_lowhigh);
+	bigint_addition_inplace(&result_middle, result_high);
+	bigint_addition_inplace(&result_middle, result_low);
+
+    /* compute result: place the low and high products, then add the middle at W^h */
+    Bigint** output = bigint_output_new(result, &tmp_result, operand_x->digit_num + operand_y->digit_num, operand_x, operand_y);
+    Word* digits = (*output)->digits;
+    size_t digit_num = (*output)->digit_num;
+
+    memcpy(digits, result_low->digits, result_low->digit_num * SIZE_OF_WORD);
+    memcpy(digits + digit_num_half * 2, result_high->digits, result_high->digit_num * SIZE_OF_WORD);
+    word_array_add(digits + digit_num_half, digits + digit_num_half, digit_num - digit_num_half,
+                   result_middle->digits, result_middle->digit_num);
 
     /* End */  
-	bigint_refine(tmp_result);
-    tmp_result->sign = (tmp_x->sign == tmp_y->sign) ? POSITIVE : NEGATIVE;
-	bigint_copy(result, tmp_result);
+	bigint_refine(*output);
+    (*output)->sign = (operand_x->sign == operand_y->sign) ? POSITIVE : NEGATIVE;
+    bigint_output_finish(result, &tmp_result);
 
     /* free */
-	bigint_delete(&x_low);
-	bigint_delete(&x_high);
-	bigint_delete(&y_low);
-	bigint_delete(&y_high);
 	bigint_delete(&result_low);
 	bigint_delete(&result_high);
 	bigint_delete(&result_middle);
 	bigint_delete(&x_lowhigh);
 	bigint_delete(&y_lowhigh);
-    bigint_delete(&tmp_x);
-    bigint_delete(&tmp_y);
-	bigint_delete(&tmp_result);	
-};
\ No newline at end of file
+    bigint_scratch_release(mark);
+};
+
+/**
+ * @brief Performs multiplication of two large integers of very different lengths.
+ * 
+ * The longer operand is split into chunks of about the length of the shorter one
+ * (views, so nothing is copied), each chunk is multiplied by the shorter operand with
+ * bigint_multiplication, which sees a balanced product, and the products are added
+ * into the result at the offsets of the chunks. Nothing is padded to the length of
+ * the longer operand, so an n x m product costs about n/m balanced m x m products.
+ * 
+ * @param result [output] Pointer to the variable to store the result of the multiplication.
+ * @param operand_x [input] Pointer to the first large integer for multiplication.
+ * @param operand_y [input] Pointer to the second large integer for multiplication.
+ */
+void bigint_multiplication_unbalanced(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    if(bigint_is_zero(operand_x) || bigint_is_zero(operand_y)) {
+        bigint_set_zero(result);
+        return;
+    }
+
+    const Bigint* operand_long = (operand_x->digit_num >= operand_y->digit_num) ? operand_x : operand_y;
+    const Bigint* operand_short = (operand_long == operand_x) ? operand_y : operand_x;
+
+    /* Chunks of equal length, none longer than the shorter operand */
+    size_t chunk_num = (operand_long->digit_num + operand_short->digit_num - 1) / operand_short->digit_num;
+    size_t chunk_size = (operand_long->digit_num + chunk_num - 1) / chunk_num;
+    size_t digit_num = operand_x->digit_num + operand_y->digit_num;
+
+    /* The magnitude of the shorter operand; the sign is set at the end */
+    Bigint multiplier = bigint_view(operand_short->digits, operand_short->digit_num, POSITIVE);
+
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* product = NULL;
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with an operand.
+    bigint_scratch_new(&product, chunk_size + operand_short->digit_num);
+    Bigint** output = bigint_output_new(result, &tmp_result, digit_num, operand_x, operand_y);
+
+    /* Accumulate chunk * multiplier at the offset of each chunk */
+    for (size_t idx = 0; idx < chunk_num; idx++) {
+        size_t offset = idx * chunk_size;
+        Bigint chunk = bigint_view_part(operand_long, offset, offset + chunk_size);
+
+        bigint_multiplication(&product, &chunk, &multiplier);
+        word_array_add((*output)->digits + offset, (*output)->digits + offset, digit_num - offset,
+                       product->digits, product->digit_num);
+    }
+
+    /* Get the result */
+    bigint_refine(*output);
+    (*output)->sign = (operand_x->sign == operand_y->sign) ? POSITIVE : NEGATIVE;
+    bigint_output_finish(result, &tmp_result);
+
+    /* Free */
+    bigint_delete(&product);
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Squares a large integer using the textbook algorithm.
+ * 
+ * Each cross product x_i * x_j is computed once and doubled, so the squaring
+ * takes about half of the word products of bigint_multiplication_textbook.
+ * 
+ * @param result [output] Pointer to the variable to store the square.
+ * @param operand [input] Pointer to the large integer to square.
+ */
+void bigint_squaring_textbook(Bigint** result, const Bigint* operand)
+{
+    if (bigint_is_zero(operand)) {
+        bigint_set_zero(result);
+        return;
+    }
+
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with an operand.
+
+    /* Allocate */
+    Bigint** output = bigint_output_new(result, &tmp_result, operand->digit_num * 2, operand, NULL);
+
+    /* Squaring: cross products once, doubled, plus the diagonal */
+    word_array_sqr_basecase((*output)->digits, operand->digits, operand->digit_num);
+
+    /* Get the result: a square is always positive */
+    bigint_refine(*output);
+    (*output)->sign = POSITIVE;
+    bigint_output_finish(result, &tmp_result);
+
+    /* Free */
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Squares a large integer using the Karatsuba algorithm.
+ * 
+ * Let x = x1 * W^h + x0. The middle term needs no general multiplication:
+ * 
+ *     x^2 = x1^2 * W^(2h) + (x1^2 + x0^2 - (x1 - x0)^2) * W^h + x0^2
+ * 
+ * so each level takes three squarings of half size, through bigint_squaring.
+ * 
+ * @param result [output] Pointer to the variable to store the square.
+ * @param operand [input] Pointer to the large integer to square.
+ */
+void bigint_squaring_karatsuba(Bigint** result, const Bigint* operand)
+{
+    /* Too short to split: the halves go through bigint_squaring, so this only stops direct calls */
+    if (operand->digit_num <= 2) {
+        bigint_squaring_textbook(result, operand);
+        return;
+    }
+
+    size_t digit_num_half = (operand->digit_num + 1) >> 1;
+
+    /* divide operand to upper and lower */
+    Bigint x_low  = bigint_view_part(operand, 0, digit_num_half);
+    Bigint x_high = bigint_view_part(operand, digit_num_half, digit_num_half * 2);
+
+    Bigint *x_lowhigh = NULL;
+    Bigint *result_low = NULL;
+    Bigint *result_high = NULL;
+    Bigint *result_middle = NULL;
+    Bigint *tmp_result = NULL;
+
+    /* Allocate temporaries with their final sizes */
+    ScratchMark mark = bigint_scratch_mark();
+    bigint_scratch_new(&x_lowhigh, digit_num_half);
+    bigint_scratch_new(&result_low, digit_num_half * 2);
+    bigint_scratch_new(&result_high, digit_num_half * 2);
+    bigint_scratch_new(&result_middle, digit_num_half * 2 + 2);
+
+    /* compute high value and low value */
+    bigint_squaring(&result_high, &x_high);
+    bigint_squaring(&result_low, &x_low);
+
+    /* compute middle value: x1^2 + x0^2 - (x1 - x0)^2 = 2 * x1 * x0 */
+    bigint_subtraction(&x_lowhigh, &x_high, &x_low);
+    bigint_squaring(&result_middle, x_lowhigh);
+    if (!bigint_is_zero(result_middle)) result_middle->sign = NEGATIVE;
+    bigint_addition_inplace(&result_middle, result_high);
+    bigint_addition_inplace(&result_middle, result_low);
+
+    /* compute result: place the low and high squares, then add the middle at W^h */
+    Bigint** output = bigint_output_new(result, &tmp_result, digit_num_half * 4, operand, NULL);
+    Word* digits = (*output)->digits;
+
+    memcpy(digits, result_low->digits, result_low->digit_num * SIZE_OF_WORD);
+    memcpy(digits + digit_num_half * 2, result_high->digits, result_high->digit_num * SIZE_OF_WORD);
+    word_array_add(digits + digit_num_half, digits + digit_num_half, digit_num_half * 3,
+                   result_middle->digits, result_middle->digit_num);
+
+    /* End */
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
+
+    /* free */
+    bigint_delete(&x_lowhigh);
+    bigint_delete(&result_low);
+    bigint_delete(&result_high);
+    bigint_delete(&result_middle);
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Squares a large integer.
+ * 
+ * [result] = [operand]^2, using the fastest squaring algorithm for the size of [operand]:
+ * textbook, Karatsuba, Toom-Cook with 5 and 7 points (evaluated once for both operands), then the NTT.
+ * The crossovers are the squaring_* fields of Thresholds.
+ * 
+ * @param result [output] Pointer to the variable to store the square.
+ * @param operand [input] Pointer to the large integer to square.
+ */
+void bigint_squaring(Bigint** result, const Bigint* operand)
+{
+    const Thresholds* thresholds = &thresholds_in_use;
+    size_t digit_num = operand->digit_num;
+
+    if (digit_num >= thresholds->squaring_ntt && digit_num * 2 <= NTT_DIGIT_NUM_MAX)
+        bigint_multiplication_ntt(result, operand, operand);
+    else if (digit_num >= thresholds->squaring_toom4)
+        bigint_multiplication_toom(result, operand, operand, 4, 4);
+    else if (digit_num >= thresholds->squaring_toom3)
+        bigint_multiplication_toom(result, operand, operand, 3, 3);
+    else if (digit_num >= thresholds->squaring_karatsuba)
+        bigint_squaring_karatsuba(result, operand);
+    else
+        bigint_squaring_textbook(result, operand);
+}
+
+/* Toom-Cook */
+
+/**
+ * @brief Negates a large integer in place (zero stays positive).
+ */
+static void toom_negate(Bigint* bigint)
+{
+    if (!bigint_is_zero(bigint))
+        bigint->sign = (bigint->sign == POSITIVE) ? NEGATIVE : POSITIVE;
+}
+
+/**
+ * @brief Divides a large integer by a small odd word in place when the division is exact.
+ */
+static void toom_divexact(Bigint* bigint, Word divisor)
+{
+    word_array_divexact_1(bigint->digits, bigint->digits, bigint->digit_num, divisor);
+    bigint_refine(bigint);
+}
+
+/**
+ * @brief Subtracts [operand] * 2^[bit_count] from [bigint] in place, using [tmp] as a temporary.
+ */
+static void toom_submul_pow2(Bigint** bigint, const Bigint* operand, size_t bit_count, Bigint** tmp)
+{
+    bigint_copy(tmp, operand);
+    bigint_shift_left_inplace(tmp, bit_count);
+    bigint_subtraction_inplace(bigint, *tmp);
+}
+
+/**
+ * @brief Replaces (s, d) with ((s + d) / 2, (s - d) / 2) in place.
+ *
+ * With the values at t and -t, this splits the even and odd coefficients of a polynomial.
+ */
+static void toom_butterfly(Bigint** sum, Bigint** difference)
+{
+    bigint_addition_inplace(sum, *difference);       // s + d
+    bigint_shift_left_inplace(difference, 1);        // 2d
+    bigint_subtraction_inplace(difference, *sum);    // d - s
+    toom_negate(*difference);                        // s - d
+
+    bigint_shift_right_inplace(sum, 1);
+    bigint_shift_right_inplace(difference, 1);
+}
+
+/**
+ * @brief Evaluates a polynomial whose coefficients are views at one point.
+ *
+ * Points are indexed in the order used by Toom-Cook: 1 is t=1, 2 is t=-1, 3 is t=2,
+ * 4 is t=-2 and 5 is t=1/2, scaled by 2^(part_num-1) to stay an integer.
+ *
+ * @param value [output] Value of the polynomial.
+ * @param parts [input] Coefficients (the parts of an operand).
+ * @param part_num [input] Number of coefficients.
+ * @param point [input] Index of the point.
+ */
+static void toom_evaluate(Bigint** value, const Bigint* parts, size_t part_num, size_t point)
+{
+    /* t = 1/2: Horner from the lowest coefficient gives sum x_i * 2^(p-1-i) */
+    if (point == 5) {
+        bigint_copy(value, &parts[0]);
+        for (size_t idx = 1; idx < part_num; idx++) {
+            bigint_shift_left_inplace(value, 1);
+            bigint_addition_inplace(value, &parts[idx]);
+        }
+        return;
+    }
+
+    /* t = 1, -1, 2, -2: Horner from the highest coefficient, value = value * t + x_i */
+    size_t bit_count = (point <= 2) ? 0 : 1;
+    bool is_negative_point = (point == 2 || point == 4);
+
+    bigint_copy(value, &parts[part_num - 1]);
+    for (size_t idx = part_num - 1; idx-- > 0;) {
+        bigint_shift_left_inplace(value, bit_count);
+        if (is_negative_point)
+            toom_negate(*value);
+        bigint_addition_inplace(value, &parts[idx]);
+    }
+}
+
+/**
+ * @brief Interpolates the product polynomial from its values in place.
+ *
+ * [values] are the products at the points 0, 1, -1, 2, -2, 1/2 (scaled by 64)
+ * and infinity, of which the first [point_num] - 1 and infinity are used.
+ * Only exact divisions by 2, 4, 3 and 5 are needed. On return, [coefficients]
+ * points to the coefficients c_0 ... c_(point_num-1) in order.
+ *
+ * @param values [input/output] Values at the points (the last one is at infinity).
+ * @param coefficients [output] Coefficients of the product polynomial.
+ * @param point_num [input] Number of points (4 to 7).
+ * @param tmp [input] Temporary.
+ */
+static void toom_interpolate(Bigint** values, Bigint** coefficients[], size_t point_num, Bigint** tmp)
+{
+    Bigint** w0 = &values[0];              // c_0
+    Bigint** w1 = &values[1];              // t = 1
+    Bigint** w2 = &values[2];              // t = -1
+    Bigint** w3 = &values[3];              // t = 2
+    Bigint** w4 = &values[4];              // t = -2
+    Bigint** w5 = &values[5];              // t = 1/2
+    Bigint** winf = &values[point_num - 1]; // c_(n-1)
+
+    /* even and odd parts at t = 1 */
+    toom_butterfly(w1, w2); // w1 = c0 + c2 + c4 + c6, w2 = c1 + c3 + c5
+
+    if (point_num == 4) {
+        bigint_subtraction_inplace(w1, *w0);   // c2
+        bigint_subtraction_inplace(w2, *winf); // c1
+
+        coefficients[0] = w0; coefficients[1] = w2; coefficients[2] = w1; coefficients[3] = winf;
+        return;
+    }
+
+    if (point_num == 5) {
+        bigint_subtraction_inplace(w1, *w0);
+        bigint_subtraction_inplace(w1, *winf);      // c2
+        bigint_subtraction_inplace(w3, *w0);
+        toom_submul_pow2(w3, *w1, 2, tmp);
+        toom_submul_pow2(w3, *winf, 4, tmp);        // 2c1 + 8c3
+        bigint_shift_right_inplace(w3, 1);
+        bigint_subtraction_inplace(w3, *w2);
+        toom_divexact(*w3, 3);                      // c3
+        bigint_subtraction_inplace(w2, *w3);        // c1
+
+        coefficients[0] = w0; coefficients[1] = w2; coefficients[2] = w1; coefficients[3] = w3; coefficients[4] = winf;
+        return;
+    }
+
+    /* even and odd parts at t = 2 */
+    toom_butterfly(w3, w4);                   // w3 = c0 + 4c2 + 16c4 + 64c6
+    bigint_shift_right_inplace(w4, 1);        // w4 = c1 + 4c3 + 16c5
+
+    if (point_num == 6) {
+        bigint_subtraction_inplace(w1, *w0);        // c2 + c4
+        bigint_subtraction_inplace(w3, *w0);
+        bigint_shift_right_inplace(w3, 2);          // c2 + 4c4
+        bigint_subtraction_inplace(w3, *w1);
+        toom_divexact(*w3, 3);                      // c4
+        bigint_subtraction_inplace(w1, *w3);        // c2
+        bigint_subtraction_inplace(w2, *winf);      // c1 + c3
+        toom_submul_pow2(w4, *winf, 4, tmp);        // c1 + 4c3
+        bigint_subtraction_inplace(w4, *w2);
+        toom_divexact(*w4, 3);                      // c3
+        bigint_subtraction_inplace(w2, *w4);        // c1
+
+        coefficients[0] = w0; coefficients[1] = w2; coefficients[2] = w1; coefficients[3] = w4; coefficients[4] = w3; coefficients[5] = winf;
+        return;
+    }
+
+    /* even coefficients */
+    bigint_subtraction_inplace(w1, *w0);
+    bigint_subtraction_inplace(w1, *winf);          // c2 + c4
+    bigint_subtraction_inplace(w3, *w0);
+    toom_submul_pow2(w3, *winf, 6, tmp);
+    bigint_shift_right_inplace(w3, 2);              // c2 + 4c4
+    bigint_subtraction_inplace(w3, *w1);
+    toom_divexact(*w3, 3);                          // c4
+    bigint_subtraction_inplace(w1, *w3);            // c2
+
+    /* odd coefficients: w5 = 16c1 + 4c3 + c5 after removing the even ones */
+    toom_submul_pow2(w5, *w0, 6, tmp);
+    toom_submul_pow2(w5, *w1, 4, tmp);
+    toom_submul_pow2(w5, *w3, 2, tmp);
+    bigint_subtraction_inplace(w5, *winf);
+    bigint_shift_right_inplace(w5, 1);
+
+    bigint_subtraction_inplace(w4, *w2);
+    toom_divexact(*w4, 3);                          // c3 + 5c5
+    bigint_subtraction_inplace(w5, *w2);
+    toom_divexact(*w5, 3);                          // 5c1 + c3
+    bigint_multiplication_word_inplace(w2, 5);
+    bigint_subtraction_inplace(w2, *w4);
+    bigint_subtraction_inplace(w2, *w5);
+    toom_divexact(*w2, 3);                          // c3
+    bigint_subtraction_inplace(w4, *w2);
+    toom_divexact(*w4, 5);                          // c5
+    bigint_subtraction_inplace(w5, *w2);
+    toom_divexact(*w5, 5);                          // c1
+
+    coefficients[0] = w0; coefficients[1] = w5; coefficients[2] = w1; coefficients[3] = w2;
+    coefficients[4] = w3; coefficients[5] = w4; coefficients[6] = winf;
+}
+
+/**
+ * @brief Performs multiplication of two large integers using the Toom-Cook algorithm.
+ * 
+ * [operand_x] is split into [parts_x] parts and [operand_y] into [parts_y] parts of
+ * k digits each, and both are seen as polynomials in W^k. The product polynomial has
+ * [parts_x] + [parts_y] - 1 coefficients, so it is determined by its values at that many
+ * points: 0, 1, -1, 2, -2, 1/2 and infinity, of which the first ones are used.
+ * 
+ *   - Evaluation: the parts are views, and the values at the other points are signed.
+ *   - Pointwise products: one multiplication of about k digits per point, through
+ *     bigint_multiplication, so each product uses the best algorithm for its size.
+ *   - Interpolation: exact divisions by small numbers and shifts on signed intermediates.
+ *   - Recomposition: the coefficients are added at multiples of k digits.
+ * 
+ * Toom-3 is (3, 3) and Toom-4 is (4, 4). Unbalanced variants such as (3, 2), (4, 2) and (4, 3)
+ * fit operands of different lengths. If [operand_x] and [operand_y] are the same object
+ * and [parts_x] == [parts_y], it is evaluated once and every pointwise product is a squaring.
+ * 
+ * @param result [output] Pointer to the variable to store the result of the multiplication.
+ * @param operand_x [input] Pointer to the first large integer for multiplication.
+ * @param operand_y [input] Pointer to the second large integer for multiplication.
+ * @param parts_x [input] Number of parts of [operand_x] (at least 2).
+ * @param parts_y [input] Number of parts of [operand_y] (at least 2).
+ */
+void bigint_multiplication_toom(Bigint** result, const Bigint* operand_x, const Bigint* operand_y, size_t parts_x, size_t parts_y)
+{
+    size_t point_num = parts_x + parts_y - 1;
+
+    /* Check invalid parameter */
+    if (parts_x < 2 || parts_y < 2 || point_num < 4 || point_num > TOOM_POINT_MAX) {
+        printf("invalid number of parts\n");
+        return;
+    }
+
+    if(bigint_is_zero(operand_x) || bigint_is_zero(operand_y)) {
+        bigint_set_zero(result);
+        return;
+    }
+
+    bool is_squaring = (operand_x == operand_y && parts_x == parts_y); // The splits must match too.
+    Sign result_sign = (operand_x->sign == operand_y->sign) ? POSITIVE : NEGATIVE;
+
+    /* Size of a part */
+    size_t part_size_x = (operand_x->digit_num + parts_x - 1) / parts_x;
+    size_t part_size_y = (operand_y->digit_num + parts_y - 1) / parts_y;
+    size_t part_size = (part_size_x > part_size_y) ? part_size_x : part_size_y;
+
+    /* Split the operands: views cost no copy */
+    Bigint parts_of_x[TOOM_POINT_MAX];
+    Bigint parts_of_y[TOOM_POINT_MAX];
+
+    for (size_t idx = 0; idx < parts_x; idx++)
+        parts_of_x[idx] = bigint_view_part(operand_x, idx * part_size, (idx + 1) * part_size);
+    for (size_t idx = 0; idx < parts_y; idx++)
+        parts_of_y[idx] = bigint_view_part(operand_y, idx * part_size, (idx + 1) * part_size);
+
+    /* Allocate temporaries: values fit into k + 1 digits and products into 2k + 2 digits */
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* value_x = NULL;
+    Bigint* value_y = NULL;
+    Bigint* values[TOOM_POINT_MAX] = { NULL };
+    Bigint** coefficients[TOOM_POINT_MAX];
+    Bigint* tmp = NULL;
+    Bigint* tmp_result = NULL;
+
+    bigint_scratch_new(&value_x, part_size + 2);
+    bigint_scratch_new(&value_y, part_size + 2);
+    for (size_t idx = 0; idx < point_num; idx++)
+        bigint_scratch_new(&values[idx], part_size * 2 + 4);
+    bigint_scratch_new(&tmp, part_size * 2 + 5);
+
+    /* Pointwise products: t = 0 and t = infinity need no evaluation */
+    bigint_multiplication(&values[0], &parts_of_x[0], is_squaring ? &parts_of_x[0] : &parts_of_y[0]);
+    bigint_multiplication(&values[point_num - 1], &parts_of_x[parts_x - 1], is_squaring ? &parts_of_x[parts_x - 1] : &parts_of_y[parts_y - 1]);
+
+    for (size_t point = 1; point < point_num - 1; point++) {
+        toom_evaluate(&value_x, parts_of_x, parts_x, point);
+
+        if (is_squaring) {
+            bigint_multiplication(&values[point], value_x, value_x);
+        } else {
+            toom_evaluate(&value_y, parts_of_y, parts_y, point);
+            bigint_multiplication(&values[point], value_x, value_y);
+        }
+    }
+
+    /* Interpolation */
+    toom_interpolate(values, coefficients, point_num, &tmp);
+
+    /* Recomposition: sum of c_i * W^(ik), the product, which has at most nx + ny digits.
+     * A tighter buffer than the parts suggest keeps a pointwise product of an outer
+     * Toom-Cook within the capacity of its temporary. */
+    size_t digit_num = operand_x->digit_num + operand_y->digit_num;
+    Bigint** output = bigint_output_new(result, &tmp_result, digit_num, operand_x, operand_y);
+
+    for (size_t idx = 0; idx < point_num; idx++) {
+        const Bigint* coefficient = *coefficients[idx];
+        size_t offset = idx * part_size;
+
+        if (bigint_is_zero(coefficient)) continue; // Beyond the top digit if a part is empty.
+
+        assert(coefficient->sign == POSITIVE && offset + coefficient->digit_num <= digit_num);
+        word_array_add((*output)->digits + offset, (*output)->digits + offset, digit_num - offset,
+                       coefficient->digits, coefficient->digit_num);
+    }
+
+    /* Get the result */
+    bigint_refine(*output);
+    (*output)->sign = result_sign;
+    bigint_output_finish(result, &tmp_result);
+
+    /* Free */
+    bigint_delete(&value_x);
+    bigint_delete(&value_y);
+    for (size_t idx = 0; idx < point_num; idx++)
+        bigint_delete(&values[idx]);
+    bigint_delete(&tmp);
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Performs multiplication of two large integers using the Toom-3 algorithm.
+ * 
+ * Balanced Toom-Cook with 3 parts per operand and 5 points. See bigint_multiplication_toom.
+ * 
+ * @param result [output] Pointer to the variable to store the result of the multiplication.
+ * @param operand_x [input] Pointer to the first large integer for multiplication.
+ * @param operand_y [input] Pointer to the second large integer for multiplication.
+ */
+void bigint_multiplication_toom3(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_multiplication_toom(result, operand_x, operand_y, 3, 3);
+}
+
+/**
+ * @brief Performs multiplication of two large integers using the Toom-4 algorithm.
+ * 
+ * Balanced Toom-Cook with 4 parts per operand and 7 points. See bigint_multiplication_toom.
+ * 
+ * @param result [output] Pointer to the variable to store the result of the multiplication.
+ * @param operand_x [input] Pointer to the first large integer for multiplication.
+ * @param operand_y [input] Pointer to the second large integer for multiplication.
+ */
+void bigint_multiplication_toom4(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_multiplication_toom(result, operand_x, operand_y, 4, 4);
+}
+
+/* Number-theoretic transform */
+
+#define NTT_PRIME_NUM 3                  ///< Number of primes the convolution is computed modulo.
+#define NTT_BLOCK_LENGTH 4096            ///< Radix-2 transforms up to this length run stage by stage (in the L1 cache).
+
+/**
+ * @brief Prime for the number-theoretic transform, with its Montgomery constants.
+ *
+ * Every prime is c * 2^k + 1 with 3 | c and k >= 25, so transforms of length 2^k and 3 * 2^k
+ * exist, and is less than 2^31, so sums of two residues fit into 32 bits.
+ */
+typedef struct {
+    uint32_t modulus;   ///< The prime p.
+    uint32_t inverse;   ///< -p^(-1) mod 2^32.
+    uint32_t r2;        ///< 2^64 mod p, to convert into Montgomery form.
+    uint32_t generator; ///< Primitive root modulo p.
+} NttPrime;
+
+static const NttPrime ntt_primes[NTT_PRIME_NUM] = {
+    { 2013265921u, 2013265919u, 1172168163u, 31 }, // 15 * 2^27 + 1
+    { 1811939329u, 1811939327u,  959408210u, 13 }, // 27 * 2^26 + 1
+    { 2113929217u, 2113929215u, 2111798781u,  5 }, // 63 * 2^25 + 1
+};
+
+/**
+ * @brief Maps [x] - p, for [x] < 2p, into [0, p) without a branch.
+ *
+ * Since p < 2^31, [x] - p wraps around to a value with the top bit set exactly when [x] < p.
+ * The residues are random, so a branch here would be mispredicted half of the time.
+ */
+static inline uint32_t ntt_correct(uint32_t x, const NttPrime* prime)
+{
+    return x + (prime->modulus & (0 - (x >> 31)));
+}
+
+/**
+ * @brief Montgomery reduction: [value] / 2^32 mod p, for [value] < p * 2^32.
+ */
+static inline uint32_t ntt_reduce(uint64_t value, const NttPrime* prime)
+{
+    uint32_t factor = (uint32_t)value * prime->inverse;
+    uint32_t reduced = (uint32_t)((value + (uint64_t)factor * prime->modulus) >> 32);
+
+    return ntt_correct(reduced - prime->modulus, prime);
+}
+
+/**
+ * @brief [x] * [y] / 2^32 mod p. With [y] in Montgomery form, this is [x] * [y] mod p in normal form.
+ */
+static inline uint32_t ntt_mul(uint32_t x, uint32_t y, const NttPrime* prime)
+{
+    return ntt_reduce((uint64_t)x * y, prime);
+}
+
+static inline uint32_t ntt_add(uint32_t x, uint32_t y, const NttPrime* prime)
+{
+    return ntt_correct(x + y - prime->modulus, prime);
+}
+
+static inline uint32_t ntt_sub(uint32_t x, uint32_t y, const NttPrime* prime)
+{
+    return ntt_correct(x - y, prime);
+}
+
+/**
+ * @brief Converts [x] < p into Montgomery form.
+ */
+static inline uint32_t ntt_to_montgomery(uint32_t x, const NttPrime* prime)
+{
+    return ntt_mul(x, prime->r2, prime);
+}
+
+/**
+ * @brief [base]^[exponent] mod p, with [base] and the result in Montgomery form.
+ */
+static uint32_t ntt_pow(uint32_t base, uint32_t exponent, const NttPrime* prime)
+{
+    uint32_t power = ntt_to_montgomery(1, prime);
+
+    for (; exponent; exponent >>= 1) {
+        if (exponent & 1)
+            power = ntt_mul(power, base, prime);
+        base = ntt_mul(base, base, prime);
+    }
+
+    return power;
+}
+
+/**
+ * @brief Fills the twiddle table of a transform of length [length] (a power of two).
+ *
+ * For every stage of half length h, table[h + j] = w^j (j < h) in Montgomery form,
+ * where w is the root of order 2h, so each stage reads its twiddles contiguously.
+ *
+ * @param table [output] Table of [length] entries (entry 0 is not used).
+ * @param length [input] Length of the transform.
+ * @param root [input] Root of order [length] in Montgomery form.
+ */
+static void ntt_twiddles(uint32_t* table, size_t length, uint32_t root, const NttPrime* prime)
+{
+    for (size_t half = length / 2; half >= 1; half /= 2) {
+        uint32_t twiddle = ntt_to_montgomery(1, prime);
+
+        for (size_t idx = 0; idx < half; idx++) {
+            table[half + idx] = twiddle;
+            twiddle = ntt_mul(twiddle, root, prime);
+        }
+        root = ntt_mul(root, root, prime);
+    }
+}
+
+/**
+ * @brief One stage of the forward transform: butterflies of half length [half] over [length] entries.
+ */
+static void ntt_forward_stage(uint32_t* data, size_t length, size_t half, const uint32_t* table, const NttPrime* prime)
+{
+    for (size_t start = 0; start < length; start += 2 * half) {
+        uint32_t* low = data + start;
+        uint32_t* high = data + start + half;
+
+        for (size_t idx = 0; idx < half; idx++) {
+            uint32_t u = low[idx];
+            uint32_t v = high[idx];
+            low[idx] = ntt_add(u, v, prime);
+            high[idx] = ntt_mul(ntt_sub(u, v, prime), table[half + idx], prime);
+        }
+    }
+}
+
+/**
+ * @brief One stage of the inverse transform: butterflies of half length [half] over [length] entries.
+ */
+static void ntt_inverse_stage(uint32_t* data, size_t length, size_t half, const uint32_t* table, const NttPrime* prime)
+{
+    for (size_t start = 0; start < length; start += 2 * half) {
+        uint32_t* low = data + start;
+        uint32_t* high = data + start + half;
+
+        for (size_t idx = 0; idx < half; idx++) {
+            uint32_t u = low[idx];
+            uint32_t v = ntt_mul(high[idx], table[half + idx], prime);
+            low[idx] = ntt_add(u, v, prime);
+            high[idx] = ntt_sub(u, v, prime);
+        }
+    }
+}
+
+/**
+ * @brief Forward transform of length 2^k, decimation in frequency (the output is in bit-reversed order).
+ *
+ * Above NTT_BLOCK_LENGTH, the halves are transformed one after the other after the first stage,
+ * so the remaining stages run on data in the cache.
+ */
+static void ntt_forward_radix2(uint32_t* data, size_t length, const uint32_t* table, const NttPrime* prime)
+{
+    if (length > NTT_BLOCK_LENGTH) {
+        ntt_forward_stage(data, length, length / 2, table, prime);
+        ntt_forward_radix2(data, length / 2, table, prime);
+        ntt_forward_radix2(data + length / 2, length / 2, table, prime);
+        return;
+    }
+
+    for (size_t half = length / 2; half >= 1; half /= 2)
+        ntt_forward_stage(data, length, half, table, prime);
+}
+
+/**
+ * @brief Inverse transform of length 2^k, decimation in time (the input is in bit-reversed order).
+ *
+ * The result is scaled by the length.
+ */
+static void ntt_inverse_radix2(uint32_t* data, size_t length, const uint32_t* table, const NttPrime* prime)
+{
+    if (length > NTT_BLOCK_LENGTH) {
+        ntt_inverse_radix2(data, length / 2, table, prime);
+        ntt_inverse_radix2(data + length / 2, length / 2, table, prime);
+        ntt_inverse_stage(data, length, length / 2, table, prime);
+        return;
+    }
+
+    for (size_t half = 1; half < length; half *= 2)
+        ntt_inverse_stage(data, length, half, table, prime);
+}
+
+/**
+ * @brief Transform of length 2^k or 3 * 2^k modulo one prime.
+ */
+typedef struct {
+    const NttPrime* prime;
+    size_t length;          ///< Length of the transform.
+    size_t block_length;    ///< Length of the radix-2 parts (the length, or a third of it).
+    uint32_t root;          ///< Root of order [length] in Montgomery form.
+    uint32_t root_inverse;  ///< Its inverse.
+    uint32_t cube_root;     ///< Primitive cube root of unity, root^block_length.
+    uint32_t scale;         ///< 1 / length, in Montgomery form twice (see ntt_pointwise).
+    uint32_t* table;        ///< Forward twiddles of the radix-2 parts.
+    uint32_t* table_inverse;///< Inverse twiddles of the radix-2 parts.
+} NttPlan;
+
+/**
+ * @brief Forward transform of [data], whose length is given by [plan].
+ *
+ * For length 3M, one radix-3 step of decimation in frequency splits [data] into three
+ * parts of length M, each of which gets a radix-2 transform.
+ */
+static void ntt_forward(uint32_t* data, const NttPlan* plan)
+{
+    const NttPrime* prime = plan->prime;
+    size_t block_length = plan->block_length;
+
+    if (plan->length != block_length) {
+        uint32_t cube_root_square = ntt_mul(plan->cube_root, plan->cube_root, prime);
+        uint32_t twiddle = ntt_to_montgomery(1, prime);
+
+        for (size_t idx = 0; idx < block_length; idx++) {
+            uint32_t x0 = data[idx];
+            uint32_t x1 = data[idx + block_length];
+            uint32_t x2 = data[idx + 2 * block_length];
+            uint32_t twiddle_square = ntt_mul(twiddle, twiddle, prime);
+
+            data[idx] = ntt_add(ntt_add(x0, x1, prime), x2, prime);
+            data[idx + block_length] = ntt_mul(ntt_add(ntt_add(x0, ntt_mul(x1, plan->cube_root, prime), prime),
+                                                       ntt_mul(x2, cube_root_square, prime), prime), twiddle, prime);
+            data[idx + 2 * block_length] = ntt_mul(ntt_add(ntt_add(x0, ntt_mul(x1, cube_root_square, prime), prime),
+                                                           ntt_mul(x2, plan->cube_root, prime), prime), twiddle_square, prime);
+
+            twiddle = ntt_mul(twiddle, plan->root, prime);
+        }
+    }
+
+    for (size_t start = 0; start < plan->length; start += block_length)
+        ntt_forward_radix2(data + start, block_length, plan->table, prime);
+}
+
+/**
+ * @brief Inverse of ntt_forward, scaled by the length.
+ */
+static void ntt_inverse(uint32_t* data, const NttPlan* plan)
+{
+    const NttPrime* prime = plan->prime;
+    size_t block_length = plan->block_length;
+
+    for (size_t start = 0; start < plan->length; start += block_length)
+        ntt_inverse_radix2(data + start, block_length, plan->table_inverse, prime);
+
+    if (plan->length != block_length) {
+        uint32_t cube_root_square = ntt_mul(plan->cube_root, plan->cube_root, prime);
+        uint32_t twiddle = ntt_to_montgomery(1, prime);
+
+        for (size_t idx = 0; idx < block_length; idx++) {
+            uint32_t twiddle_square = ntt_mul(twiddle, twiddle, prime);
+            uint32_t y0 = data[idx];
+            uint32_t y1 = ntt_mul(data[idx + block_length], twiddle, prime);
+            uint32_t y2 = ntt_mul(data[idx + 2 * block_length], twiddle_square, prime);
+
+            data[idx] = ntt_add(ntt_add(y0, y1, prime), y2, prime);
+            data[idx + block_length] = ntt_add(ntt_add(y0, ntt_mul(y1, cube_root_square, prime), prime),
+                                               ntt_mul(y2, plan->cube_root, prime), prime);
+            data[idx + 2 * block_length] = ntt_add(ntt_add(y0, ntt_mul(y1, plan->cube_root, prime), prime),
+                                                   ntt_mul(y2, cube_root_square, prime), prime);
+
+            twiddle = ntt_mul(twiddle, plan->root_inverse, prime);
+        }
+    }
+}
+
+/**
+ * @brief Prepares a transform of length [length] modulo [prime]. The twiddle tables are given by the caller.
+ */
+static void ntt_plan_setup(NttPlan* plan, const NttPrime* prime, size_t length, uint32_t* table, uint32_t* table_inverse)
+{
+    plan->prime = prime;
+    plan->length = length;
+    plan->block_length = (length % 3 == 0) ? length / 3 : length;
+    plan->table = table;
+    plan->table_inverse = table_inverse;
+
+    uint32_t generator = ntt_to_montgomery(prime->generator, prime);
+    plan->root = ntt_pow(generator, (uint32_t)((prime->modulus - 1) / length), prime);
+    plan->root_inverse = ntt_pow(plan->root, (uint32_t)(length - 1), prime);
+    plan->cube_root = ntt_pow(plan->root, (uint32_t)plan->block_length, prime);
+
+    /* (1/length) * 2^32 * 2^32: ntt_pointwise removes one 2^32 per Montgomery product */
+    uint32_t length_inverse = ntt_pow(ntt_to_montgomery((uint32_t)(length % prime->modulus), prime), prime->modulus - 2, prime);
+    plan->scale = ntt_to_montgomery(length_inverse, prime);
+
+    /* The radix-2 parts use the root of order block_length */
+    uint32_t block_root = ntt_pow(plan->root, (uint32_t)(length / plan->block_length), prime);
+    ntt_twiddles(table, plan->block_length, block_root, prime);
+    ntt_twiddles(table_inverse, plan->block_length, ntt_pow(block_root, (uint32_t)(plan->block_length - 1), prime), prime);
+}
+
+/**
+ * @brief Reads the [idx]-th coefficient of NTT_CHUNK_BITLEN bits of a word array (zero past its end).
+ */
+static uint32_t ntt_get_chunk(const Word* digits, size_t digit_num, size_t idx)
+{
+    uint32_t chunk = 0;
+    size_t bit = idx * NTT_CHUNK_BITLEN;
+
+    for (size_t filled = 0; filled < NTT_CHUNK_BITLEN;) {
+        size_t word_idx = (bit + filled) / BITLEN_OF_WORD;
+        size_t shift = (bit + filled) % BITLEN_OF_WORD;
+
+        if (word_idx >= digit_num)
+            break;
+        chunk |= (uint32_t)(digits[word_idx] >> shift) << filled;
+        filled += BITLEN_OF_WORD - shift;
+    }
+
+    return chunk;
+}
+
+/**
+ * @brief Writes the [idx]-th coefficient of NTT_CHUNK_BITLEN bits into a zeroed word array (bits past its end are dropped).
+ */
+static void ntt_put_chunk(Word* digits, size_t digit_num, size_t idx, uint32_t chunk)
+{
+    size_t bit = idx * NTT_CHUNK_BITLEN;
+
+    for (size_t filled = 0; filled < NTT_CHUNK_BITLEN;) {
+        size_t word_idx = (bit + filled) / BITLEN_OF_WORD;
+        size_t shift = (bit + filled) % BITLEN_OF_WORD;
+
+        if (word_idx >= digit_num)
+            break;
+        digits[word_idx] |= (Word)((Word)(chunk >> filled) << shift);
+        filled += BITLEN_OF_WORD - shift;
+    }
+}
+
+/**
+ * @brief Loads the coefficients of an operand reduced modulo a prime, padded with zeros.
+ */
+static void ntt_load(uint32_t* data, size_t length, const Bigint* operand, size_t chunk_num, const NttPrime* prime)
+{
+    for (size_t idx = 0; idx < chunk_num; idx++)
+        data[idx] = ntt_get_chunk(operand->digits, operand->digit_num, idx) % prime->modulus;
+    memset(data + chunk_num, 0, (length - chunk_num) * sizeof(uint32_t));
+}
+
+/**
+ * @brief Multiplies two transforms pointwise into [data_x] and divides by the length.
+ */
+static void ntt_pointwise(uint32_t* data_x, const uint32_t* data_y, const NttPlan* plan)
+{
+    for (size_t idx = 0; idx < plan->length; idx++)
+        data_x[idx] = ntt_mul(ntt_mul(data_x[idx], data_y[idx], plan->prime), plan->scale, plan->prime);
+}
+
+/**
+ * @brief Chooses the length of the transform: the least 2^k or 3 * 2^k holding [coefficient_num] coefficients.
+ *
+ * @return size_t The length, or 0 if the primes do not support it.
+ */
+static size_t ntt_length(size_t coefficient_num)
+{
+    size_t length = 1;
+
+    while (length < coefficient_num)
+        length *= 2;
+    if (length / 4 * 3 >= coefficient_num && length >= 4)
+        length = length / 4 * 3;
+
+    return (length <= NTT_LENGTH_MAX) ? length : 0;
+}
+
+/**
+ * @brief Performs multiplication of two large integers using the number-theoretic transform.
+ * 
+ * The operands are cut into coefficients of 32 bits, and their cyclic convolution is computed
+ * modulo three primes below 2^31 with a transform of length 2^k or 3 * 2^k,
+ * so the length is at most 1.5 times the number of coefficients of the product instead of 2 times.
+ * Each coefficient of the product is less than length * 2^64 < p0 * p1 * p2, so it is
+ * recovered exactly from its three residues by the Chinese remainder theorem (Garner's method)
+ * while the carries are propagated.
+ * 
+ * The arithmetic modulo the primes uses Montgomery multiplication on 32-bit words, so it needs
+ * no wider type than uint64_t on any word size. The cost is O(n log n), so this is the algorithm
+ * for operands of many thousands of words. Products of more than 3 * 2^25 coefficients
+ * (about 400 MB) are not supported.
+ * 
+ * @param result [output] Pointer to the variable to store the result of the multiplication.
+ * @param operand_x [input] Pointer to the first large integer for multiplication.
+ * @param operand_y [input] Pointer to the second large integer for multiplication.
+ */
+void bigint_multiplication_ntt(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    if(bigint_is_zero(operand_x) || bigint_is_zero(operand_y)) {
+        bigint_set_zero(result);
+        return;
+    }
+
+    bool is_squaring = (operand_x == operand_y);
+    Sign result_sign = (operand_x->sign == operand_y->sign) ? POSITIVE : NEGATIVE;
+
+    size_t chunk_num_x = (operand_x->digit_num * BITLEN_OF_WORD + NTT_CHUNK_BITLEN - 1) / NTT_CHUNK_BITLEN;
+    size_t chunk_num_y = (operand_y->digit_num * BITLEN_OF_WORD + NTT_CHUNK_BITLEN - 1) / NTT_CHUNK_BITLEN;
+    size_t coefficient_num = chunk_num_x + chunk_num_y - 1;
+    size_t length = ntt_length(coefficient_num);
+
+    /* Check invalid parameter */
+    if (length == 0) {
+        printf("operands are too large for the NTT\n");
+        return;
+    }
+
+    /* Allocate temporaries: one residue array per prime, the transform of y and the twiddles */
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* residues[NTT_PRIME_NUM] = { NULL };
+    Bigint* transform_y = NULL;
+    Bigint* tables = NULL;
+    Bigint* tmp_result = NULL;
+    size_t array_digit_num = (length * sizeof(uint32_t) + SIZE_OF_WORD - 1) / SIZE_OF_WORD;
+
+    for (size_t idx = 0; idx < NTT_PRIME_NUM; idx++)
+        bigint_scratch_new(&residues[idx], array_digit_num);
+    if (!is_squaring)
+        bigint_scratch_new(&transform_y, array_digit_num);
+    bigint_scratch_new(&tables, array_digit_num * 2);
+
+    uint32_t* table = (uint32_t*)tables->digits;
+    uint32_t* table_inverse = table + length;
+
+    /* Convolution modulo each prime */
+    for (size_t idx = 0; idx < NTT_PRIME_NUM; idx++) {
+        const NttPrime* prime = &ntt_primes[idx];
+        uint32_t* data_x = (uint32_t*)residues[idx]->digits;
+        NttPlan plan;
+
+        ntt_plan_setup(&plan, prime, length, table, table_inverse);
+        ntt_load(data_x, length, operand_x, chunk_num_x, prime);
+        ntt_forward(data_x, &plan);
+
+        if (is_squaring) {
+            ntt_pointwise(data_x, data_x, &plan);
+        } else {
+            uint32_t* data_y = (uint32_t*)transform_y->digits;
+            ntt_load(data_y, length, operand_y, chunk_num_y, prime);
+            ntt_forward(data_y, &plan);
+            ntt_pointwise(data_x, data_y, &plan);
+        }
+
+        ntt_inverse(data_x, &plan);
+    }
+
+    /* CRT (Garner): c = r0 + p0 * (t1 + p1 * t2), with t1 < p1 and t2 < p2 */
+    const NttPrime* prime0 = &ntt_primes[0];
+    const NttPrime* prime1 = &ntt_primes[1];
+    const NttPrime* prime2 = &ntt_primes[2];
+    uint32_t inverse01 = ntt_pow(ntt_to_montgomery(prime0->modulus % prime1->modulus, prime1), prime1->modulus - 2, prime1);
+    uint32_t inverse02 = ntt_pow(ntt_to_montgomery(prime0->modulus % prime2->modulus, prime2), prime2->modulus - 2, prime2);
+    uint32_t inverse12 = ntt_pow(ntt_to_montgomery(prime1->modulus % prime2->modulus, prime2), prime2->modulus - 2, prime2);
+    uint64_t modulus01 = (uint64_t)prime0->modulus * prime1->modulus;
+    const uint32_t* data0 = (const uint32_t*)residues[0]->digits;
+    const uint32_t* data1 = (const uint32_t*)residues[1]->digits;
+    const uint32_t* data2 = (const uint32_t*)residues[2]->digits;
+
+    size_t digit_num = operand_x->digit_num + operand_y->digit_num;
+    size_t chunk_num = (digit_num * BITLEN_OF_WORD + NTT_CHUNK_BITLEN - 1) / NTT_CHUNK_BITLEN;
+    Bigint** output = bigint_output_new(result, &tmp_result, digit_num, operand_x, operand_y);
+    uint64_t carry[3] = { 0, 0, 0 }; // 32-bit limbs of the carry
+
+    for (size_t idx = 0; idx < chunk_num; idx++) {
+        uint64_t low = 0, middle_low = 0, middle_high = 0;
+
+        if (idx < coefficient_num) {
+            uint32_t r0 = data0[idx];
+            uint32_t t1 = ntt_mul(ntt_sub(data1[idx], r0 % prime1->modulus, prime1), inverse01, prime1);
+            uint32_t t2 = ntt_mul(ntt_sub(ntt_mul(ntt_sub(data2[idx], r0 % prime2->modulus, prime2), inverse02, prime2),
+                                          t1, prime2), inverse12, prime2);
+
+            low = r0 + (uint64_t)prime0->modulus * t1;
+            middle_low = (uint64_t)(uint32_t)modulus01 * t2;
+            middle_high = (modulus01 >> 32) * t2;
+        }
+
+        /* carry + low + modulus01 * t2, by 32-bit limbs */
+        uint64_t limb0 = carry[0] + (low & 0xFFFFFFFF) + (middle_low & 0xFFFFFFFF);
+        uint64_t limb1 = carry[1] + (low >> 32) + (middle_low >> 32) + (middle_high & 0xFFFFFFFF) + (limb0 >> 32);
+        uint64_t limb2 = carry[2] + (middle_high >> 32) + (limb1 >> 32);
+
+        ntt_put_chunk((*output)->digits, digit_num, idx, (uint32_t)limb0);
+        carry[0] = limb1 & 0xFFFFFFFF;
+        carry[1] = limb2 & 0xFFFFFFFF;
+        carry[2] = limb2 >> 32;
+    }
+
+    /* Get the result */
+    bigint_refine(*output);
+    (*output)->sign = result_sign;
+    bigint_output_finish(result, &tmp_result);
+
+    /* Free */
+    for (size_t idx = 0; idx < NTT_PRIME_NUM; idx++)
+        bigint_delete(&residues[idx]);
+    bigint_delete(&transform_y);
+    bigint_delete(&tables);
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Chooses the numbers of parts of Toom-Cook for operands of different lengths.
+ * 
+ * Among the splits with at most [point_max] points, the one with the least estimated
+ * cost (number of points * k^2, for parts of k digits) is chosen, so a longer operand
+ * is split into more parts.
+ * 
+ * @param parts_x [output] Number of parts of the first operand.
+ * @param parts_y [output] Number of parts of the second operand.
+ * @param digit_num_x [input] Number of digits of the first operand.
+ * @param digit_num_y [input] Number of digits of the second operand.
+ * @param point_max [input] Largest number of points (5 or 7).
+ */
+static void toom_choose_parts(size_t* parts_x, size_t* parts_y, size_t digit_num_x, size_t digit_num_y, size_t point_max)
+{
+    size_t cost_min = SIZE_MAX;
+
+    for (size_t split_x = 2; split_x < point_max; split_x++) {
+        for (size_t split_y = 2; split_x + split_y - 1 <= point_max; split_y++) {
+            if (split_x + split_y - 1 < 4) continue;
+
+            size_t part_size_x = (digit_num_x + split_x - 1) / split_x;
+            size_t part_size_y = (digit_num_y + split_y - 1) / split_y;
+            size_t part_size = (part_size_x > part_size_y) ? part_size_x : part_size_y;
+            size_t cost = (split_x + split_y - 1) * part_size * part_size;
+
+            if (cost < cost_min) {
+                cost_min = cost;
+                *parts_x = split_x;
+                *parts_y = split_y;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Performs multiplication of two large integers.
+ * 
+ * [result] = [operand_x] * [operand_y], using the fastest algorithm for the sizes of the operands.
+ * Every algorithm is used from its threshold in Thresholds up, checked from the top,
+ * so each threshold is honored whatever order the values are in:
+ * 
+ *   - NTT, as long as the product is not too long for it
+ *   - Toom-Cook with 7 points (Toom-4 or an unbalanced variant)
+ *   - Toom-Cook with 5 points (Toom-3 or an unbalanced variant)
+ *   - Karatsuba
+ *   - Comba, and textbook below it
+ * 
+ * The size of the shorter operand decides. Below the NTT, an operand [unbalanced_ratio]
+ * times longer than the other is split into chunks (bigint_multiplication_unbalanced)
+ * before the other tiers are checked, if the chunks reach one of the Toom-Cook or
+ * Karatsuba thresholds; the chunks then go through this function as balanced products.
+ * A squaring goes to bigint_squaring.
+ * 
+ * All multiplications of the library go through this function, so tuning the thresholds
+ * with bigint_set_thresholds speeds up all of them.
+ * 
+ * @param result [output] Pointer to the variable to store the result of the multiplication.
+ * @param operand_x [input] Pointer to the first large integer for multiplication.
+ * @param operand_y [input] Pointer to the second large integer for multiplication.
+ */
+void bigint_multiplication(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    if (operand_x == operand_y) {
+        bigint_squaring(result, operand_x);
+        return;
+    }
+
+    const Thresholds* thresholds = &thresholds_in_use;
+    size_t digit_num_min = operand_x->digit_num < operand_y->digit_num ? operand_x->digit_num : operand_y->digit_num;
+    size_t digit_num_max = operand_x->digit_num + operand_y->digit_num - digit_num_min;
+    size_t parts_x = 3, parts_y = 3;
+
+    /* Lowest threshold of a subquadratic tier a chunk of an unbalanced product can reach */
+    size_t subquadratic = thresholds->karatsuba;
+    if (subquadratic > thresholds->toom3) subquadratic = thresholds->toom3;
+    if (subquadratic > thresholds->toom4) subquadratic = thresholds->toom4;
+
+    if (digit_num_min >= thresholds->ntt && digit_num_min + digit_num_max <= NTT_DIGIT_NUM_MAX) {
+        bigint_multiplication_ntt(result, operand_x, operand_y);
+    } else if (digit_num_min >= subquadratic && digit_num_max / thresholds->unbalanced_ratio >= digit_num_min) {
+        bigint_multiplication_unbalanced(result, operand_x, operand_y);
+    } else if (digit_num_min >= thresholds->toom4) {
+        toom_choose_parts(&parts_x, &parts_y, operand_x->digit_num, operand_y->digit_num, TOOM_POINT_MAX);
+        bigint_multiplication_toom(result, operand_x, operand_y, parts_x, parts_y);
+    } else if (digit_num_min >= thresholds->toom3) {
+        toom_choose_parts(&parts_x, &parts_y, operand_x->digit_num, operand_y->digit_num, 5);
+        bigint_multiplication_toom(result, operand_x, operand_y, parts_x, parts_y);
+    } else if (digit_num_min >= thresholds->karatsuba) {
+        bigint_multiplication_karatsuba(result, operand_x, operand_y);
+    } else if (digit_num_min >= thresholds->comba) {
+        bigint_multiplication_comba(result, operand_x, operand_y);
+    } else {
+        bigint_multiplication_textbook(result, operand_x, operand_y);
+    }
+}
@@ -1,40 +1,20 @@
 #include "autobahn.h"
+#include "autobahn_kernel.h"
 
 /**
  * @brief Pre-computation for Barrett reduction.
  * 
  * Calculates the pre-computed value for Barrett reduction using the modulus [modular].
  * Let W is word and n is number of digits of [modular].
- * Then the [barret_pre_computed] is W^(2n) / N.
+ * Then the [barret_pre_computed] is W^(2n) / N, computed by bigint_reciprocal
+ * (Newton iteration for long moduli).
  * 
  * @param barrett_pre_computed [output] Result of pre-computation for Barrett reduction.
  * @param modular [input] The modulus value.
  */
 void bigint_reduction_barrett_pre_computed(Bigint** barrett_pre_computed, const Bigint* modular) 
 {
-    /* Allocate Bigint */
-    Bigint* remainder = NULL;
-    Bigint* quotient = NULL; // This will be pre_computed value in barrett reduction.
-    Bigint* dividend = NULL; // W^(2n)
-    bigint_new(&remainder, 1);
-    bigint_new(&quotient, 1);
-    bigint_new(&dividend, 1);
-
-    /* Initialize dividend */
-    bigint_set_one(&dividend);
-    bigint_expand(&dividend, dividend, 2 * modular->digit_num); // W^(2n)
-
-    /* compute divide */
-    bigint_division_binary_long(&quotient, &remainder, dividend, modular); // W^(2n) / N
-    
-    /* Get result */
-    bigint_refine(quotient);
-    bigint_copy(barrett_pre_computed, quotient);
-
-    /* Free Bigint */
-    bigint_delete(&remainder);
-    bigint_delete(&quotient);
-    bigint_delete(&dividend);
+    bigint_reciprocal(barrett_pre_computed, modular, 2 * modular->digit_num); // W^(2n) / N
 }
 
 /**
@@ -62,28 +42,106 @@ void bigint_reduction_barrett(Bigint** result, const Bigint* bigint, const Bigin
 
     /* Allocate Bigint */
     Bigint* quotient = NULL;
-    Bigint* remainder = NULL; // This will be result of barrett reduction.
-    bigint_new(&quotient, 1);
-    bigint_new(&remainder, 1);
+    Bigint* product = NULL;
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with [bigint] or [modular].
+    ScratchMark mark = bigint_scratch_mark();
+    bigint_scratch_new(&quotient, modular->digit_num * 2 + 2);
+    bigint_scratch_new(&product, modular->digit_num * 2 + 1);
 
     /* Barrett reduction: Compute quotient: quotient is Q, Q+1 or Q+2 */
-    bigint_compress(&quotient, bigint, modular->digit_num - 1);   // Q <- A >> W^(n-1)
-    bigint_multiplication_textbook(&quotient, quotient, pre_computed);     // Q <- (A >> W^(n-1)) * T
+    Bigint bigint_high = bigint_view_part(bigint, modular->digit_num - 1, bigint->digit_num);    // A >> W^(n-1), no copy
+    bigint_multiplication(&quotient, &bigint_high, pre_computed);                                // Q <- (A >> W^(n-1)) * T
     bigint_compress(&quotient, quotient, modular->digit_num + 1); // Q <- ((A >> W^(n-1)) * T) >> W^(n+1)
 
     /* Barrett reduction: Compute remainder: remainder is R, R+N or R+2N */
-    bigint_multiplication_textbook(&remainder, quotient, modular); // R <- Q * N
-    bigint_subtraction(&remainder, bigint, remainder);    // R <- A - Q * N
+    Bigint** output = bigint_output_new(result, &tmp_result, modular->digit_num * 2 + 1, bigint, modular);
+    bigint_multiplication(&product, quotient, modular);   // Q * N
+    bigint_subtraction(output, bigint, product);          // R <- A - Q * N
 
     /* Barrett reduction: Find correct result */
-    while (bigint_compare(remainder, modular) != LEFT_IS_SMALL)
-        bigint_subtraction(&remainder, remainder, modular); // make R if remainder is R + N or R + 2N
+    while (bigint_compare(*output, modular) != LEFT_IS_SMALL)
+        bigint_subtraction_inplace(output, modular); // make R if remainder is R + N or R + 2N
 
     /* Get result */
-    bigint_refine(remainder);
-    bigint_copy(result, remainder);
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
 
     /* Free Bigint */
     bigint_delete(&quotient);
-    bigint_delete(&remainder);
-}
\ No newline at end of file
+    bigint_delete(&product);
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Barrett reduction in place.
+ * 
+ * [bigint] <- [bigint] mod [modular], without allocating a new result:
+ * Q*N is subtracted from [bigint] in place, and the quotient and Q*N are
+ * temporaries in the scratch arena. See bigint_reduction_barrett for [pre_computed].
+ * 
+ * Aliasing: [modular] and [pre_computed] must not share digits with *[bigint].
+ * Debug builds check this.
+ * 
+ * @param bigint [input/output] Memory address of the large integer to reduce.
+ * @param modular [input] The modulus value.
+ * @param pre_computed [input] Pre-computed values for Barrett reduction.
+ */
+void bigint_reduction_barrett_inplace(Bigint** bigint, const Bigint* modular, const Bigint* pre_computed)
+{
+    /* Check invalid parameter : A is in W^2n */
+    if ((*bigint)->digit_num > modular->digit_num * 2) {
+        printf("Do not barrett\n");
+        return;
+    }
+
+    assert(!bigint_is_aliased(*bigint, modular) && !bigint_is_aliased(*bigint, pre_computed));
+
+    /* Allocate Bigint */
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* quotient = NULL;
+    Bigint* quotient_modular = NULL; // Q * N
+    bigint_scratch_new(&quotient, modular->digit_num * 2 + 2);
+    bigint_scratch_new(&quotient_modular, modular->digit_num * 2 + 1);
+
+    /* Barrett reduction: Compute quotient: quotient is Q, Q+1 or Q+2 */
+    Bigint bigint_high = bigint_view_part(*bigint, modular->digit_num - 1, (*bigint)->digit_num);        // A >> W^(n-1)
+    bigint_multiplication(&quotient, &bigint_high, pre_computed);                                        // (A >> W^(n-1)) * T
+    Bigint quotient_high = bigint_view_part(quotient, modular->digit_num + 1, quotient->digit_num);       // Q
+    bigint_multiplication(&quotient_modular, &quotient_high, modular);                                   // Q * N
+
+    /* Barrett reduction: A <- A - Q * N, then A is R, R+N or R+2N */
+    bigint_subtraction_unsigned_inplace(bigint, quotient_modular);
+
+    while (bigint_compare_abs(*bigint, modular) != LEFT_IS_SMALL)
+        bigint_subtraction_unsigned_inplace(bigint, modular);
+
+    /* Free Bigint */
+    bigint_delete(&quotient);
+    bigint_delete(&quotient_modular);
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Reduction by a single word.
+ * 
+ * Returns [bigint] mod [modular] with one pass over the digits of [bigint].
+ * No quotient is written, so nothing is allocated.
+ * 
+ * @param bigint [input] The large integer to be reduced (non-negative).
+ * @param modular [input] The modulus word (non-zero).
+ * @return Word [bigint] mod [modular].
+ */
+Word bigint_reduction_word(const Bigint* bigint, Word modular)
+{
+    /* Check invalid parameter */
+    if (modular == 0) {
+        printf("modular must be non-zero\n");
+        return 0;
+    }
+    if (bigint->sign == NEGATIVE) {
+        printf("bigint must be positive\n");
+        return 0;
+    }
+
+    return word_array_divrem_1(NULL, bigint->digits, bigint->digit_num, modular);
+}
@@ -1,66 +1,34 @@
 #include "autobahn.h"
-
-/**
- * @brief Performs subtraction of two words with a borrow and determines the next borrow.
- * 
- * This function subtracts [operand_y] from [operand_x] along with the [current_borrow].
- * The result is stored in [result], and the function sets [next_borrow] if the result is negative.
- * 
- * borrow condition : let r = x - y. if x < y then borrow is set.
- * 
- * @param result [output] Result of the subtraction.
- * @param next_borrow [output] Borrow from the current subtraction.
- * @param current_borrow [input] Borrow from the previous subtraction.
- * @param operand_x [input] First operand of the subtraction.
- * @param operand_y [input] Second operand of the subtraction.
- */
-static void word_subtraction_with_borrow(Word* result, Word* next_borrow, Word current_borrow, Word operand_x, Word operand_y) 
-{
-    *result      = operand_x - operand_y;       // r = x - y
-    *next_borrow = operand_x < operand_y;       // set borrow
-    *next_borrow += *result < current_borrow;   // set borrow
-    *result      -= current_borrow;             // r = x - y - b
-}
+#include "autobahn_kernel.h"
 
 /**
  * @brief Performs unsigned subtraction of two large integers.
  * 
  * This function subtracts the value of [operand_y] from [operand_x] and stores the result in [result].
  * It is assumed that [operand_x] is larger than or equal to [operand_y].
+ * The operands may have different numbers of digits and are not modified.
  * 
  * @param result [output] Result of the subtraction.
  * @param operand_x [input] First operand of the subtraction.
  * @param operand_y [input] Second operand of the subtraction.
  */
-void bigint_subtraction_unsigned(Bigint** result, Bigint* operand_x, Bigint* operand_y)
+void bigint_subtraction_unsigned(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
 {
-    Word current_borrow = 0;
-    Word next_borrow = 0;
-    Bigint* tmp_result = NULL;  // This will be the result.
-
-    /* Make operands have the same number of digits */
-    if (operand_x->digit_num != operand_y->digit_num) {
-        operand_y->digits = (Word*)realloc(operand_y->digits, operand_x->digit_num * SIZE_OF_WORD);
-        operand_y->digit_num = operand_x->digit_num;
-    }
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with an operand.
 
     /* Allocate Bigint */
-    bigint_new(&tmp_result, operand_x->digit_num);
+    Bigint** output = bigint_output_new(result, &tmp_result, operand_x->digit_num, operand_x, operand_y);
 
-    /* Subtraction word by word */
-    for (int idx = 0; idx < operand_x->digit_num; idx++) 
-    {
-        word_subtraction_with_borrow(&(tmp_result->digits[idx]), &next_borrow, current_borrow, operand_x->digits[idx], operand_y->digits[idx]);
-        current_borrow = next_borrow; // Update the borrow.
-    }
+    /* Subtraction word by word: no borrow is left because x >= y */
+    word_array_sub((*output)->digits, operand_x->digits, operand_x->digit_num, operand_y->digits, operand_y->digit_num);
 
     /* Get result */
-    bigint_refine(operand_y);
-    bigint_refine(tmp_result);
-    bigint_copy(result, tmp_result);
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
 
     /* Free Bigint */
-    bigint_delete(&tmp_result);
+    bigint_scratch_release(mark);
 }
 
 /**
@@ -74,67 +42,178 @@ void bigint_subtraction_unsigned(Bigint** result, Bigint* operand_x, Bigint* ope
  */
 void bigint_subtraction(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
 {
-    /* Use temporary variables to avoid modifying the input operands */
-    Bigint* tmp_x = NULL;
-    Bigint* tmp_y = NULL;
+    /* Case: result = operand_x - (-operand_y) or (-operand_x) - operand_y */
+    if (operand_x->sign != operand_y->sign) 
+    {
+        Sign result_sign = operand_x->sign; // [result] may be the same object as an operand.
 
-    /* Allocate Bigint */
-    bigint_new(&tmp_x, operand_x->digit_num);
-    bigint_new(&tmp_y, operand_y->digit_num);
-
-    /* Input Operands */
-    bigint_copy(&tmp_x, operand_x);
-    bigint_copy(&tmp_y, operand_y);
-
-    /* Case: result = operand_x - (-operand_y) */
-    if (tmp_x->sign == POSITIVE && tmp_y->sign == NEGATIVE) {
-        tmp_y->sign = POSITIVE;
-        bigint_addition(result, tmp_x, tmp_y);
-        (*result)->sign = POSITIVE;
-        goto RETURN;
-    }
+        if (operand_x->digit_num >= operand_y->digit_num)
+            bigint_addition_unsigned(result, operand_x, operand_y);
+        else
+            bigint_addition_unsigned(result, operand_y, operand_x);
 
-    /* Case: result = (-operand_x) - operand_y */
-    if (tmp_x->sign == NEGATIVE && tmp_y->sign == POSITIVE) {
-        tmp_x->sign = POSITIVE;
-        bigint_addition(result, tmp_x, tmp_y);
-        (*result)->sign = NEGATIVE;
-        goto RETURN;
+        (*result)->sign = result_sign;
+        return;
     }
 
+    char who_is_big = bigint_compare_abs(operand_x, operand_y);
+
     /* Case: operand_x == operand_y */
-    if(bigint_compare(tmp_x, tmp_y) == SAME) {
+    if (who_is_big == SAME) {
         bigint_set_zero(result);
-        goto RETURN;
+        return;
     }
 
-    /* Case: operand_x > operand_y */
-    if (bigint_compare_abs(tmp_x, tmp_y) == LEFT_IS_BIG) 
+    /* Case: |operand_x| > |operand_y|, the result has the sign of operand_x */
+    if (who_is_big == LEFT_IS_BIG) 
     {
-        bigint_subtraction_unsigned(result, tmp_x, tmp_y);
-        
-        /* Set the sign of the result */
-        if (tmp_x->sign == POSITIVE && tmp_y->sign == POSITIVE) (*result)->sign = POSITIVE;
-	    if (tmp_x->sign == NEGATIVE && tmp_y->sign == NEGATIVE) (*result)->sign = NEGATIVE;
-
-        goto RETURN;
+        Sign result_sign = operand_x->sign;
+        bigint_subtraction_unsigned(result, operand_x, operand_y);
+        (*result)->sign = result_sign;
     }
+    /* Case: |operand_x| < |operand_y|, the result has the opposite sign */
     else
     {
-        bigint_subtraction_unsigned(result, tmp_y, tmp_x);
+        Sign result_sign = (operand_x->sign == POSITIVE) ? NEGATIVE : POSITIVE;
+        bigint_subtraction_unsigned(result, operand_y, operand_x);
+        (*result)->sign = result_sign;
+    }
+}
+
+/**
+ * @brief Subtracts absolute values in place.
+ * 
+ * |bigint| <- | |bigint| - |operand| |. The sign of [bigint] is not changed,
+ * so the caller sets it (compare the absolute values first).
+ * [operand] must not be aliased with [bigint].
+ * 
+ * @param bigint [input/output] Memory address of the large integer to update.
+ * @param operand [input] Operand of the subtraction.
+ */
+void bigint_subtraction_unsigned_inplace(Bigint** bigint, const Bigint* operand)
+{
+    assert(!bigint_is_aliased(*bigint, operand));
+
+    /* Case: |bigint| >= |operand| */
+    if (bigint_compare_abs(*bigint, operand) != LEFT_IS_SMALL) {
+        word_array_sub((*bigint)->digits, (*bigint)->digits, (*bigint)->digit_num, operand->digits, operand->digit_num);
+        bigint_refine(*bigint);
+        return;
+    }
+
+    /* Case: |bigint| < |operand|, pad with zero digits then compute |operand| - |bigint| */
+    bigint_resize(bigint, operand->digit_num);
+    word_array_sub_n((*bigint)->digits, operand->digits, (*bigint)->digits, operand->digit_num);
+    bigint_refine(*bigint);
+}
+
+/**
+ * @brief Subtracts a large integer from another large integer in place.
+ * 
+ * [bigint] <- [bigint] - [operand], without allocating a new result.
+ * 
+ * Aliasing: [operand] may be *[bigint] itself (the result is zero), but it must not
+ * otherwise share digits with *[bigint] (for example, a view of it). Debug builds check this.
+ * 
+ * @param bigint [input/output] Memory address of the large integer to update.
+ * @param operand [input] Operand of the subtraction.
+ */
+void bigint_subtraction_inplace(Bigint** bigint, const Bigint* operand)
+{
+    /* Case: x -= x */
+    if (*bigint == operand) {
+        bigint_set_zero(bigint);
+        return;
+    }
+
+    assert(!bigint_is_aliased(*bigint, operand));
+
+    /* Case: different signs, x - (-y) = x + y */
+    if ((*bigint)->sign != operand->sign) {
+        bigint_addition_unsigned_inplace(bigint, operand);
+        return;
+    }
+
+    /* Case: same signs, the sign flips if |x| < |y| */
+    char who_is_big = bigint_compare_abs(*bigint, operand);
+
+    bigint_subtraction_unsigned_inplace(bigint, operand);
 
-        /* Set the sign of the result */
-        if (tmp_x->sign == POSITIVE && tmp_y->sign == POSITIVE) (*result)->sign = NEGATIVE;
-	    if (tmp_x->sign == NEGATIVE && tmp_y->sign == NEGATIVE) (*result)->sign = POSITIVE;
+    if (who_is_big == LEFT_IS_SMALL) (*bigint)->sign = ((*bigint)->sign == POSITIVE) ? NEGATIVE : POSITIVE;
+    if (who_is_big == SAME) (*bigint)->sign = POSITIVE;
+}
+/**
+ * @brief Subtracts a single word from a large integer.
+ * 
+ * [result] <- [bigint] - [word] in one pass over the digits: the borrow is
+ * propagated only until it dies, and the rest of the digits are copied.
+ * [result] may be the same object as [bigint].
+ * 
+ * @param result [output] Result of the subtraction.
+ * @param bigint [input] Large integer operand.
+ * @param word [input] Word to subtract.
+ */
+void bigint_subtraction_word(Bigint** result, const Bigint* bigint, Word word)
+{
+    /* Case: (-x) - word = -(x + word) */
+    if (bigint->sign == NEGATIVE) {
+        Bigint magnitude = bigint_view(bigint->digits, bigint->digit_num, POSITIVE); // |x|, no copy
+        bigint_addition_word(result, &magnitude, word);
+        (*result)->sign = NEGATIVE;
+        return;
+    }
 
-        goto RETURN;
+    /* Case: x < word, the result is -(word - x) */
+    if (bigint->digit_num == 1 && bigint->digits[0] < word) {
+        Word difference = word - bigint->digits[0];
+        bigint_set_zero(result);
+        (*result)->digits[0] = difference;
+        (*result)->sign = NEGATIVE;
+        return;
     }
 
-    RETURN:
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint* tmp_result = NULL; // Used only if [result] is aliased with [bigint].
+
+    /* Allocate Bigint */
+    Bigint** output = bigint_output_new(result, &tmp_result, bigint->digit_num, bigint, NULL);
+
+    /* Subtraction: x >= word, so there is no borrow out */
+    word_array_sub_1((*output)->digits, bigint->digits, bigint->digit_num, word);
+
+    /* Get result */
+    bigint_refine(*output);
+    bigint_output_finish(result, &tmp_result);
 
     /* Free Bigint */
-    bigint_delete(&tmp_x);
-    bigint_delete(&tmp_y);
+    bigint_scratch_release(mark);
+}
+
+/**
+ * @brief Subtracts a single word from a large integer in place.
+ * 
+ * [bigint] <- [bigint] - [word], without allocating a new result.
+ * 
+ * @param bigint [input/output] Memory address of the large integer to update.
+ * @param word [input] Word to subtract.
+ */
+void bigint_subtraction_word_inplace(Bigint** bigint, Word word)
+{
+    /* Case: (-x) - word = -(x + word) */
+    if ((*bigint)->sign == NEGATIVE) {
+        (*bigint)->sign = POSITIVE;
+        bigint_addition_word_inplace(bigint, word);
+        (*bigint)->sign = NEGATIVE;
+        return;
+    }
+
+    /* Case: x < word, the sign flips */
+    if ((*bigint)->digit_num == 1 && (*bigint)->digits[0] < word) {
+        (*bigint)->digits[0] = word - (*bigint)->digits[0];
+        (*bigint)->sign = NEGATIVE;
+        return;
+    }
 
-    return;
-}
\ No newline at end of file
+    word_array_sub_1((*bigint)->digits, (*bigint)->digits, (*bigint)->digit_num, word);
+    bigint_refine(*bigint);
+}
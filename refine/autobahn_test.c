@@ -1,4 +1,5 @@
 #include "autobahn_test.h"
+#include "autobahn_kernel.h" // 2-by-1 word division is checked directly
 
 /* read integer from file */
 static void read_integer_from_file(Bigint** bigint, FILE* testvector_file)
@@ -20,7 +21,7 @@ static void write_integer_into_file(FILE* file, Bigint* x)
     fprintf(file, PRINT_WORD_FORMAT, x->digits[x->digit_num - 1]);
 
 	// write bigint integer.
-    for (int i = x->digit_num - 2; i >= 0; i--)
+    for (size_t i = x->digit_num - 1; i-- > 0;)
         fprintf(file, PRINT_WORD_FIX_FORMAT, x->digits[i]);
 
     fprintf(file, "\n");
@@ -134,4 +135,2094 @@ void bigint_test_div()
     fclose(f_operand_y);
     fclose(f_result_q);
     fclose(f_result_r);
-}
\ No newline at end of file
+}
+/*-----------------------------------------------------------*/
+/* Checks against known results                              */
+/*-----------------------------------------------------------*/
+
+typedef void (*BinaryOperation)(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+typedef void (*UnaryOperation)(Bigint** result, const Bigint* operand);
+
+/* Signs of the operands in the known result files (bit i is sign_names[i]) */
+#define SIGNS_PP 0x1
+#define SIGNS_PN 0x2
+#define SIGNS_NP 0x4
+#define SIGNS_NN 0x8
+#define SIGNS_ALL 0xF
+
+#define RANDOM_TRIAL_NUM 3 ///< Random operands per length.
+#define FAILURE_SHOW_NUM 3 ///< Failed checks shown per test.
+
+static const char* const sign_names[4] = { "pp", "pn", "np", "nn" };
+
+/* Where an operation writes its result: a separate Bigint, or over one of the operands */
+typedef enum {
+    ALIAS_NONE = 0,
+    ALIAS_X = 1,
+    ALIAS_Y = 2
+} Alias;
+
+/* open file or exit */
+static FILE* open_file(const char* file_path)
+{
+    FILE* file = fopen(file_path, "r");
+
+    if (file == NULL) {
+        perror(file_path);
+        exit(1);
+    }
+
+    return file;
+}
+
+/* open known results of an operation, e.g. ("mul", "pn") */
+static FILE* open_known_results(const char* operation_name, const char* signs)
+{
+    char file_path[64];
+
+    snprintf(file_path, sizeof(file_path), KNOWN_RESULT_FILE_PATH, operation_name, signs);
+    return open_file(file_path);
+}
+
+/* read signed integer from file: FALSE if there is no result (DIV0!) */
+static char read_known_result_from_file(Bigint** bigint, FILE* testvector_file)
+{
+    char buffer[TEST_VECTOR_SIZE] = {0};
+
+    fscanf(testvector_file, "%s", buffer);
+    if (strcmp(buffer, "DIV0!") == 0) return FALSE;
+
+    Sign sign = (buffer[0] == '-') ? NEGATIVE : POSITIVE;
+    bigint_set_by_hex_string(bigint, buffer + (sign == NEGATIVE), sign);
+    bigint_refine(*bigint); // zero is positive
+
+    return TRUE;
+}
+
+/* set the signs of the operands of a test vector */
+static void set_signs(Bigint* operand_x, Bigint* operand_y, const char* signs)
+{
+    if (bigint_is_zero(operand_x) == FALSE) operand_x->sign = (signs[0] == 'n') ? NEGATIVE : POSITIVE;
+    if (bigint_is_zero(operand_y) == FALSE) operand_y->sign = (signs[1] == 'n') ? NEGATIVE : POSITIVE;
+}
+
+/* random integer with a random sign */
+static void generate_random_operand(Bigint** bigint, size_t digit_num)
+{
+    bigint_generate_random_number(bigint, (rand() & 1) ? NEGATIVE : POSITIVE, digit_num);
+    bigint_refine(*bigint); // zero is positive
+}
+
+/* count a failed check and show the first ones */
+static void record_failure(const char* name, size_t* failed, const Bigint* operand_x, const Bigint* operand_y)
+{
+    if ((*failed)++ >= FAILURE_SHOW_NUM) return;
+
+    printf("%s failed: x = ", name);
+    bigint_show_hex(operand_x);
+    if (operand_y != NULL) {
+        printf("  y = ");
+        bigint_show_hex(operand_y);
+    }
+}
+
+/* print the result of a test */
+static size_t report(const char* name, size_t total, size_t failed)
+{
+    printf("%-64s %7zu checks: %s\n", name, total, (failed == 0) ? "ok" : "FAILED");
+    return failed;
+}
+
+/* run a binary operation, writing over an operand if asked */
+static void run_binary_operation(BinaryOperation operation, Bigint** result, const Bigint* operand_x, const Bigint* operand_y, Alias alias)
+{
+    if (alias == ALIAS_X) {
+        bigint_copy(result, operand_x);
+        operation(result, *result, operand_y);
+    } else if (alias == ALIAS_Y) {
+        bigint_copy(result, operand_y);
+        operation(result, operand_x, *result);
+    } else {
+        operation(result, operand_x, operand_y);
+    }
+}
+
+/**
+ * @brief Checks a binary operation on every test vector against the known results.
+ * 
+ * @param name [input] Name of the test.
+ * @param operation [input] Operation to check.
+ * @param operation_name [input] Operation of the known result files ("add", "sub", "mul").
+ * @param signs [input] Signs of the operands to check (SIGNS_*).
+ * @param alias [input] Operand the result is written over.
+ * @param word_operand [input] TRUE to skip the vectors whose y does not fit into a word.
+ * @return size_t Number of failed checks.
+ */
+static size_t test_binary_operation(const char* name, BinaryOperation operation, const char* operation_name, int signs, Alias alias, char word_operand)
+{
+    Bigint* operand_x = NULL;
+    Bigint* operand_y = NULL;
+    Bigint* result = NULL;
+    Bigint* expected = NULL;
+    size_t total = 0, failed = 0;
+
+    for (int idx_sign = 0; idx_sign < 4; idx_sign++)
+    {
+        if ((signs & (1 << idx_sign)) == 0) continue;
+
+        FILE* f_operand_x = open_file(OPERAND_X_FILE_PATH);
+        FILE* f_operand_y = open_file(OPERAND_Y_FILE_PATH);
+        FILE* f_expected = open_known_results(operation_name, sign_names[idx_sign]);
+
+        for (size_t idx = 0; idx < TEST_VECTOR_NUM; idx++)
+        {
+            read_integer_from_file(&operand_x, f_operand_x);
+            read_integer_from_file(&operand_y, f_operand_y);
+            if (read_known_result_from_file(&expected, f_expected) == FALSE) continue;
+            if (word_operand == TRUE && operand_y->digit_num > 1) continue;
+
+            set_signs(operand_x, operand_y, sign_names[idx_sign]);
+            run_binary_operation(operation, &result, operand_x, operand_y, alias);
+
+            total++;
+            if (bigint_compare(result, expected) != SAME)
+                record_failure(name, &failed, operand_x, operand_y);
+        }
+
+        fclose(f_operand_x);
+        fclose(f_operand_y);
+        fclose(f_expected);
+    }
+
+    bigint_delete(&operand_x);
+    bigint_delete(&operand_y);
+    bigint_delete(&result);
+    bigint_delete(&expected);
+
+    return report(name, total, failed);
+}
+
+/* Karatsuba only: the faster algorithms are checked against it */
+static void multiplication_reference(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    Thresholds thresholds, reference;
+
+    bigint_get_thresholds(&thresholds);
+    reference = thresholds;
+    reference.toom3 = reference.toom4 = reference.ntt = (size_t)-1;
+    reference.squaring_toom3 = reference.squaring_toom4 = reference.squaring_ntt = (size_t)-1;
+    reference.unbalanced_ratio = (size_t)-1;
+
+    bigint_set_thresholds(&reference);
+    bigint_multiplication(result, operand_x, operand_y);
+    bigint_set_thresholds(&thresholds);
+}
+
+/**
+ * @brief Checks a binary operation on random operands of the given lengths against a reference operation.
+ * 
+ * @param reference [input] Operation giving the expected results.
+ * @param lengths [input] Pairs of lengths of x and y in digits.
+ * @param length_num [input] Number of pairs.
+ * @return size_t Number of failed checks.
+ */
+static size_t test_binary_operation_random(const char* name, BinaryOperation operation, BinaryOperation reference, const size_t (*lengths)[2], size_t length_num, Alias alias)
+{
+    Bigint* operand_x = NULL;
+    Bigint* operand_y = NULL;
+    Bigint* result = NULL;
+    Bigint* expected = NULL;
+    size_t total = 0, failed = 0;
+
+    for (size_t idx = 0; idx < length_num; idx++)
+    {
+        for (int trial = 0; trial < RANDOM_TRIAL_NUM; trial++)
+        {
+            generate_random_operand(&operand_x, lengths[idx][0]);
+            generate_random_operand(&operand_y, lengths[idx][1]);
+
+            run_binary_operation(operation, &result, operand_x, operand_y, alias);
+            reference(&expected, operand_x, operand_y);
+
+            total++;
+            if (bigint_compare(result, expected) != SAME)
+                record_failure(name, &failed, operand_x, operand_y);
+        }
+    }
+
+    bigint_delete(&operand_x);
+    bigint_delete(&operand_y);
+    bigint_delete(&result);
+    bigint_delete(&expected);
+
+    return report(name, total, failed);
+}
+
+/* multiplication on random operands against multiplication_reference */
+static size_t test_multiplication_random(const char* name, BinaryOperation operation, const size_t (*lengths)[2], size_t length_num, Alias alias)
+{
+    return test_binary_operation_random(name, operation, multiplication_reference, lengths, length_num, alias);
+}
+
+/**
+ * @brief Checks a squaring on every x of the test vectors and on random operands.
+ * 
+ * The result is compared with the product of two distinct copies of the operand,
+ * and the squaring is also run with the result written over the operand.
+ * 
+ * @param lengths [input] Lengths of the random operands in digits.
+ * @param length_num [input] Number of lengths.
+ * @return size_t Number of failed checks.
+ */
+static size_t test_squaring(const char* name, UnaryOperation operation, const size_t* lengths, size_t length_num)
+{
+    Bigint* operand = NULL;
+    Bigint* operand_copy = NULL;
+    Bigint* result = NULL;
+    Bigint* expected = NULL;
+    size_t total = 0, failed = 0;
+    FILE* f_operand_x = open_file(OPERAND_X_FILE_PATH);
+
+    for (size_t idx = 0; idx < TEST_VECTOR_NUM + length_num * RANDOM_TRIAL_NUM; idx++)
+    {
+        if (idx < TEST_VECTOR_NUM)
+            read_integer_from_file(&operand, f_operand_x);
+        else
+            generate_random_operand(&operand, lengths[(idx - TEST_VECTOR_NUM) / RANDOM_TRIAL_NUM]);
+
+        bigint_copy(&operand_copy, operand);
+        multiplication_reference(&expected, operand, operand_copy);
+
+        /* x^2, then x <- x^2 */
+        operation(&result, operand);
+        total++;
+        if (bigint_compare(result, expected) != SAME)
+            record_failure(name, &failed, operand, NULL);
+
+        operation(&operand_copy, operand_copy);
+        total++;
+        if (bigint_compare(operand_copy, expected) != SAME)
+            record_failure(name, &failed, operand, NULL);
+    }
+
+    fclose(f_operand_x);
+    bigint_delete(&operand);
+    bigint_delete(&operand_copy);
+    bigint_delete(&result);
+    bigint_delete(&expected);
+
+    return report(name, total, failed);
+}
+
+/* Toom-Cook with the split in toom_parts */
+static size_t toom_parts[2] = { 3, 3 };
+
+static void multiplication_toom_split(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_multiplication_toom(result, operand_x, operand_y, toom_parts[0], toom_parts[1]);
+}
+
+static void squaring_toom_split(Bigint** result, const Bigint* operand)
+{
+    bigint_multiplication_toom(result, operand, operand, toom_parts[0], toom_parts[1]);
+}
+
+static void squaring_by_multiplication(Bigint** result, const Bigint* operand)
+{
+    bigint_multiplication(result, operand, operand);
+}
+
+static void squaring_ntt(Bigint** result, const Bigint* operand)
+{
+    bigint_multiplication_ntt(result, operand, operand);
+}
+
+/* bigint_multiplication and bigint_squaring with every threshold low, so that the recursion mixes all tiers */
+static void multiplication_low_thresholds(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    Thresholds thresholds;
+    Thresholds low;
+
+    bigint_get_thresholds(&thresholds);
+    low = thresholds;
+    low.comba = 4;
+    low.karatsuba = low.squaring_karatsuba = 8;
+    low.toom3 = low.squaring_toom3 = 16;
+    low.toom4 = low.squaring_toom4 = 32;
+    low.ntt = low.squaring_ntt = 96;
+    low.unbalanced_ratio = 2;
+
+    bigint_set_thresholds(&low);
+    if (operand_x == operand_y)
+        bigint_squaring(result, operand_x);
+    else
+        bigint_multiplication(result, operand_x, operand_y);
+    bigint_set_thresholds(&thresholds);
+}
+
+static void squaring_low_thresholds(Bigint** result, const Bigint* operand)
+{
+    multiplication_low_thresholds(result, operand, operand);
+}
+
+/**
+ * @brief Checks every multiplication and squaring algorithm.
+ * 
+ * The algorithms are checked on the test vectors against the known results, with the
+ * result written to a new Bigint and over each operand. Long operands are checked against
+ * Karatsuba, which is itself checked against the textbook multiplication first.
+ * The NTT is also checked through bigint_multiplication and bigint_squaring above its
+ * thresholds, and all tiers together with every threshold lowered.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_multiplication()
+{
+    static const BinaryOperation operations[] = {
+        bigint_multiplication_textbook, bigint_multiplication_comba, bigint_multiplication_karatsuba,
+        bigint_multiplication_unbalanced, bigint_multiplication_toom3, bigint_multiplication_toom4,
+        bigint_multiplication
+    };
+    static const char* const operation_names[] = {
+        "multiplication_textbook", "multiplication_comba", "multiplication_karatsuba",
+        "multiplication_unbalanced", "multiplication_toom3", "multiplication_toom4",
+        "multiplication"
+    };
+    static const size_t toom_splits[][2] = { {3, 3}, {4, 4}, {3, 2}, {4, 2}, {4, 3}, {5, 2}, {6, 2}, {2, 3}, {3, 4}, {2, 4}, {2, 5} };
+    static const size_t toom_part_lengths[] = { 1, 40, 300 };
+    static const size_t square_lengths[] = { 1, 2, 5, 33, 100, 400, 1000 };
+    static const size_t reference_lengths[][2] = { {1, 1}, {3, 70}, {70, 70}, {300, 200}, {1000, 1000} };
+    static const size_t comba_lengths[][2] = { {8, 8}, {40, 7}, {200, 200}, {300, 300} }; // 8-bit words: columns over COMBA_COLUMN_MAX
+    static const size_t unbalanced_lengths[][2] = { {2000, 37}, {37, 2000}, {5000, 300}, {900, 450} };
+    static const size_t ntt_lengths[][2] = { {1, 1}, {100, 3}, {700, 700}, {3000, 1000} };
+    Thresholds thresholds;
+    char name[64];
+    size_t failed = 0;
+
+    /* Known results, with the result written over each operand */
+    for (size_t idx = 0; idx < sizeof(operations) / sizeof(operations[0]); idx++)
+    {
+        snprintf(name, sizeof(name), "%s", operation_names[idx]);
+        failed += test_binary_operation(name, operations[idx], "mul", SIGNS_ALL, ALIAS_NONE, FALSE);
+        snprintf(name, sizeof(name), "%s (result is x)", operation_names[idx]);
+        failed += test_binary_operation(name, operations[idx], "mul", SIGNS_ALL, ALIAS_X, FALSE);
+        snprintf(name, sizeof(name), "%s (result is y)", operation_names[idx]);
+        failed += test_binary_operation(name, operations[idx], "mul", SIGNS_ALL, ALIAS_Y, FALSE);
+    }
+
+    /* Long operands */
+    failed += test_multiplication_random("multiplication_textbook (long)", bigint_multiplication_textbook, reference_lengths, 5, ALIAS_NONE);
+    failed += test_multiplication_random("multiplication_comba (long)", bigint_multiplication_comba, comba_lengths, 4, ALIAS_NONE);
+    failed += test_multiplication_random("multiplication_unbalanced (long)", bigint_multiplication_unbalanced, unbalanced_lengths, 4, ALIAS_X);
+    failed += test_multiplication_random("multiplication (long)", bigint_multiplication, unbalanced_lengths, 4, ALIAS_Y);
+
+    /* Every Toom-Cook split, on short operands and on operands cut into parts of many digits */
+    for (size_t idx = 0; idx < sizeof(toom_splits) / sizeof(toom_splits[0]); idx++)
+    {
+        size_t lengths[3][2];
+        toom_parts[0] = toom_splits[idx][0];
+        toom_parts[1] = toom_splits[idx][1];
+
+        for (size_t idx_length = 0; idx_length < 3; idx_length++) {
+            lengths[idx_length][0] = toom_parts[0] * toom_part_lengths[idx_length] - idx_length; // the top part may be shorter
+            lengths[idx_length][1] = toom_parts[1] * toom_part_lengths[idx_length];
+        }
+
+        snprintf(name, sizeof(name), "multiplication_toom (%zu, %zu)", toom_parts[0], toom_parts[1]);
+        failed += test_binary_operation(name, multiplication_toom_split, "mul", SIGNS_ALL, ALIAS_NONE, FALSE);
+        snprintf(name, sizeof(name), "multiplication_toom (%zu, %zu, long)", toom_parts[0], toom_parts[1]);
+        failed += test_multiplication_random(name, multiplication_toom_split, (const size_t (*)[2])lengths, 3, ALIAS_X);
+        snprintf(name, sizeof(name), "multiplication_toom (%zu, %zu, x * x)", toom_parts[0], toom_parts[1]);
+        failed += test_squaring(name, squaring_toom_split, square_lengths, sizeof(square_lengths) / sizeof(square_lengths[0]));
+    }
+
+    /* Squaring */
+    failed += test_squaring("squaring_textbook", bigint_squaring_textbook, square_lengths, sizeof(square_lengths) / sizeof(square_lengths[0]));
+    failed += test_squaring("squaring_karatsuba", bigint_squaring_karatsuba, square_lengths, sizeof(square_lengths) / sizeof(square_lengths[0]));
+    failed += test_squaring("squaring", bigint_squaring, square_lengths, sizeof(square_lengths) / sizeof(square_lengths[0]));
+    failed += test_squaring("multiplication (x * x)", squaring_by_multiplication, square_lengths, sizeof(square_lengths) / sizeof(square_lengths[0]));
+
+    /* NTT, then the dispatchers above the NTT thresholds and with every threshold low */
+    failed += test_binary_operation("multiplication_ntt", bigint_multiplication_ntt, "mul", SIGNS_ALL, ALIAS_NONE, FALSE);
+    failed += test_binary_operation("multiplication_ntt (result is x)", bigint_multiplication_ntt, "mul", SIGNS_ALL, ALIAS_X, FALSE);
+    failed += test_binary_operation("multiplication_ntt (result is y)", bigint_multiplication_ntt, "mul", SIGNS_ALL, ALIAS_Y, FALSE);
+    failed += test_multiplication_random("multiplication_ntt (long)", bigint_multiplication_ntt, ntt_lengths, 4, ALIAS_X);
+    failed += test_squaring("multiplication_ntt (x * x)", squaring_ntt, square_lengths, sizeof(square_lengths) / sizeof(square_lengths[0]));
+
+    bigint_get_thresholds(&thresholds);
+    size_t over_ntt_lengths[][2] = { {thresholds.ntt, thresholds.ntt}, {thresholds.ntt + 5, thresholds.ntt * 3} };
+    size_t over_squaring_ntt_lengths[] = { thresholds.squaring_ntt + 3 };
+
+    failed += test_multiplication_random("multiplication (over the NTT threshold)", bigint_multiplication, (const size_t (*)[2])over_ntt_lengths, 2, ALIAS_NONE);
+    failed += test_squaring("squaring (over the NTT threshold)", bigint_squaring, over_squaring_ntt_lengths, 1);
+
+    failed += test_binary_operation("multiplication (low thresholds)", multiplication_low_thresholds, "mul", SIGNS_ALL, ALIAS_X, FALSE);
+    failed += test_multiplication_random("multiplication (low thresholds, long)", multiplication_low_thresholds, unbalanced_lengths, 4, ALIAS_Y);
+    failed += test_squaring("squaring (low thresholds)", squaring_low_thresholds, square_lengths, sizeof(square_lengths) / sizeof(square_lengths[0]));
+
+    return failed;
+}
+
+typedef void (*DivisionOperation)(Bigint** quotient, Bigint** remainder, const Bigint* dividend, const Bigint* divisor);
+
+/* Where a division writes its results: separate Bigints, or over one of the operands */
+typedef enum {
+    DIVISION_ALIAS_NONE = 0,
+    QUOTIENT_IS_DIVIDEND = 1,
+    REMAINDER_IS_DIVIDEND = 2,
+    QUOTIENT_IS_DIVISOR = 3,
+    REMAINDER_IS_DIVISOR = 4
+} DivisionAlias;
+
+static const char* const division_alias_names[] = {
+    "", " (quotient is dividend)", " (remainder is dividend)", " (quotient is divisor)", " (remainder is divisor)"
+};
+
+/* run a division, writing over an operand if asked */
+static void run_division(DivisionOperation operation, Bigint** quotient, Bigint** remainder, const Bigint* dividend, const Bigint* divisor, DivisionAlias alias)
+{
+    switch (alias)
+    {
+    case QUOTIENT_IS_DIVIDEND:
+        bigint_copy(quotient, dividend);
+        operation(quotient, remainder, *quotient, divisor);
+        break;
+    case REMAINDER_IS_DIVIDEND:
+        bigint_copy(remainder, dividend);
+        operation(quotient, remainder, *remainder, divisor);
+        break;
+    case QUOTIENT_IS_DIVISOR:
+        bigint_copy(quotient, divisor);
+        operation(quotient, remainder, dividend, *quotient);
+        break;
+    case REMAINDER_IS_DIVISOR:
+        bigint_copy(remainder, divisor);
+        operation(quotient, remainder, dividend, *remainder);
+        break;
+    default:
+        operation(quotient, remainder, dividend, divisor);
+        break;
+    }
+}
+
+/**
+ * @brief Checks a division on every test vector with a non-zero divisor against the known results.
+ * 
+ * @param alias [input] Operand the results are written over.
+ * @param word_operand [input] TRUE to skip the vectors whose divisor does not fit into a word.
+ * @return size_t Number of failed checks.
+ */
+static size_t test_division(const char* name, DivisionOperation operation, DivisionAlias alias, char word_operand)
+{
+    Bigint* dividend = NULL;
+    Bigint* divisor = NULL;
+    Bigint* quotient = NULL;
+    Bigint* remainder = NULL;
+    Bigint* expected_q = NULL;
+    Bigint* expected_r = NULL;
+    size_t total = 0, failed = 0;
+    char full_name[96];
+
+    FILE* f_operand_x = open_file(OPERAND_X_FILE_PATH);
+    FILE* f_operand_y = open_file(OPERAND_Y_FILE_PATH);
+    FILE* f_expected_q = open_known_results("div_q", "pp");
+    FILE* f_expected_r = open_known_results("div_r", "pp");
+
+    snprintf(full_name, sizeof(full_name), "%s%s", name, division_alias_names[alias]);
+
+    for (size_t idx = 0; idx < TEST_VECTOR_NUM; idx++)
+    {
+        read_integer_from_file(&dividend, f_operand_x);
+        read_integer_from_file(&divisor, f_operand_y);
+        char known_q = read_known_result_from_file(&expected_q, f_expected_q);
+        char known_r = read_known_result_from_file(&expected_r, f_expected_r);
+        if (known_q == FALSE || known_r == FALSE) continue;
+        if (word_operand == TRUE && divisor->digit_num > 1) continue;
+
+        run_division(operation, &quotient, &remainder, dividend, divisor, alias);
+
+        total++;
+        if (bigint_compare(quotient, expected_q) != SAME || bigint_compare(remainder, expected_r) != SAME)
+            record_failure(full_name, &failed, dividend, divisor);
+    }
+
+    fclose(f_operand_x);
+    fclose(f_operand_y);
+    fclose(f_expected_q);
+    fclose(f_expected_r);
+
+    bigint_delete(&dividend);
+    bigint_delete(&divisor);
+    bigint_delete(&quotient);
+    bigint_delete(&remainder);
+    bigint_delete(&expected_q);
+    bigint_delete(&expected_r);
+
+    return report(full_name, total, failed);
+}
+
+/* checks A = BQ + R (where 0 <= R < B) */
+static char is_division_correct(const Bigint* dividend, const Bigint* divisor, const Bigint* quotient, const Bigint* remainder)
+{
+    Bigint* product = NULL;
+    char correct;
+
+    multiplication_reference(&product, quotient, divisor);
+    bigint_addition(&product, product, remainder);
+
+    correct = (bigint_compare(product, dividend) == SAME && remainder->sign == POSITIVE && quotient->sign == POSITIVE &&
+               bigint_compare(remainder, divisor) == LEFT_IS_SMALL) ? TRUE : FALSE;
+
+    bigint_delete(&product);
+    return correct;
+}
+
+/**
+ * @brief Checks a division on random operands of the given lengths.
+ * 
+ * Every length is tried with a random divisor, a divisor of all-one digits, and a dividend
+ * that is a multiple of the divisor plus the divisor minus one (the largest remainders).
+ * The results are checked with A = BQ + R (where 0 <= R < B).
+ * 
+ * @param lengths [input] Pairs of lengths of the dividend and the divisor in digits.
+ * @param length_num [input] Number of pairs.
+ * @return size_t Number of failed checks.
+ */
+static size_t test_division_random(const char* name, DivisionOperation operation, const size_t (*lengths)[2], size_t length_num, DivisionAlias alias)
+{
+    Bigint* dividend = NULL;
+    Bigint* divisor = NULL;
+    Bigint* quotient = NULL;
+    Bigint* remainder = NULL;
+    size_t total = 0, failed = 0;
+    char full_name[96];
+
+    snprintf(full_name, sizeof(full_name), "%s%s", name, division_alias_names[alias]);
+
+    for (size_t idx = 0; idx < length_num; idx++)
+    {
+        for (int trial = 0; trial < RANDOM_TRIAL_NUM; trial++)
+        {
+            bigint_generate_random_number(&dividend, POSITIVE, lengths[idx][0]);
+            bigint_generate_random_number(&divisor, POSITIVE, lengths[idx][1]);
+
+            if (trial == 1) {
+                for (size_t idx_digit = 0; idx_digit < lengths[idx][1]; idx_digit++)
+                    divisor->digits[idx_digit] = (Word)-1;
+                divisor->digit_num = lengths[idx][1];
+            }
+            if (bigint_is_zero(divisor) == TRUE) bigint_set_one(&divisor);
+            if (trial == 2 && lengths[idx][0] > lengths[idx][1]) {
+                bigint_generate_random_number(&quotient, POSITIVE, lengths[idx][0] - lengths[idx][1]);
+                multiplication_reference(&dividend, quotient, divisor);
+                bigint_addition(&dividend, dividend, divisor);
+                bigint_set_one(&remainder);
+                bigint_subtraction(&dividend, dividend, remainder); // Q * B + (B - 1)
+            }
+
+            run_division(operation, &quotient, &remainder, dividend, divisor, alias);
+
+            total++;
+            if (is_division_correct(dividend, divisor, quotient, remainder) == FALSE)
+                record_failure(full_name, &failed, dividend, divisor);
+        }
+    }
+
+    bigint_delete(&dividend);
+    bigint_delete(&divisor);
+    bigint_delete(&quotient);
+    bigint_delete(&remainder);
+
+    return report(full_name, total, failed);
+}
+
+/* Burnikel-Ziegler with the division threshold in division_threshold, so short divisors recurse too */
+static size_t division_threshold = 2;
+
+static void division_burnikel_ziegler_low(Bigint** quotient, Bigint** remainder, const Bigint* dividend, const Bigint* divisor)
+{
+    Thresholds thresholds, low;
+
+    bigint_get_thresholds(&thresholds);
+    low = thresholds;
+    low.burnikel_ziegler = division_threshold;
+
+    bigint_set_thresholds(&low);
+    bigint_division_burnikel_ziegler(quotient, remainder, dividend, divisor);
+    bigint_set_thresholds(&thresholds);
+}
+
+/* Newton division and bigint_division with the Newton threshold in division_threshold */
+static void division_newton_low(Bigint** quotient, Bigint** remainder, const Bigint* dividend, const Bigint* divisor)
+{
+    Thresholds thresholds, low;
+
+    bigint_get_thresholds(&thresholds);
+    low = thresholds;
+    low.newton = division_threshold;
+
+    bigint_set_thresholds(&low);
+    bigint_division_newton(quotient, remainder, dividend, divisor);
+    bigint_set_thresholds(&thresholds);
+}
+
+static void division_low_newton_threshold(Bigint** quotient, Bigint** remainder, const Bigint* dividend, const Bigint* divisor)
+{
+    Thresholds thresholds, low;
+
+    bigint_get_thresholds(&thresholds);
+    low = thresholds;
+    low.newton = division_threshold;
+
+    bigint_set_thresholds(&low);
+    bigint_division(quotient, remainder, dividend, divisor);
+    bigint_set_thresholds(&thresholds);
+}
+
+/**
+ * @brief Checks bigint_reciprocal on random divisors: R = floor(W^k / D) if R*D <= W^k < (R+1)*D.
+ * 
+ * @param newton_threshold [input] Newton threshold while the reciprocals are computed.
+ * @return size_t Number of failed checks.
+ */
+static size_t test_reciprocal(const char* name, size_t newton_threshold)
+{
+    static const size_t divisor_lengths[] = { 1, 2, 3, 5, 40, 300, 1000 };
+    Thresholds thresholds, low;
+    Bigint* divisor = NULL;
+    Bigint* reciprocal = NULL;
+    Bigint* product = NULL;
+    Bigint* power = NULL;
+    size_t total = 0, failed = 0;
+
+    bigint_get_thresholds(&thresholds);
+    low = thresholds;
+    low.newton = newton_threshold;
+
+    for (size_t idx = 0; idx < sizeof(divisor_lengths) / sizeof(divisor_lengths[0]); idx++)
+    {
+        size_t length = divisor_lengths[idx];
+        size_t exponents[] = { length, length + 1, 2 * length, 2 * length + 3, 3 * length };
+
+        for (size_t idx_exponent = 0; idx_exponent < sizeof(exponents) / sizeof(exponents[0]); idx_exponent++)
+        {
+            for (int trial = 0; trial < RANDOM_TRIAL_NUM; trial++)
+            {
+                bigint_generate_random_number(&divisor, POSITIVE, length);
+                if (trial == 1) bigint_shift_right_inplace(&divisor, 1); // a top bit that is not set
+                if (bigint_is_zero(divisor) == TRUE) bigint_set_one(&divisor);
+
+                /* W^k */
+                bigint_new(&power, exponents[idx_exponent] + 1);
+                power->digits[exponents[idx_exponent]] = 1;
+
+                bigint_set_thresholds(&low);
+                if (trial == 2) { // reciprocal written over the divisor
+                    bigint_copy(&reciprocal, divisor);
+                    bigint_reciprocal(&reciprocal, reciprocal, exponents[idx_exponent]);
+                } else {
+                    bigint_reciprocal(&reciprocal, divisor, exponents[idx_exponent]);
+                }
+                bigint_set_thresholds(&thresholds);
+
+                /* R*D <= W^k, then W^k < (R+1)*D */
+                multiplication_reference(&product, reciprocal, divisor);
+                char correct = (bigint_compare(product, power) != LEFT_IS_BIG) ? TRUE : FALSE;
+                bigint_addition(&product, product, divisor);
+                if (bigint_compare(product, power) != LEFT_IS_BIG) correct = FALSE;
+
+                total++;
+                if (correct == FALSE)
+                    record_failure(name, &failed, divisor, NULL);
+            }
+        }
+    }
+
+    bigint_delete(&divisor);
+    bigint_delete(&reciprocal);
+    bigint_delete(&product);
+    bigint_delete(&power);
+
+    return report(name, total, failed);
+}
+
+/**
+ * @brief Checks every division algorithm.
+ * 
+ * The algorithms are checked on the test vectors against the known results, with the
+ * results written to new Bigints and over each operand. Random operands cover a dividend
+ * shorter than the divisor, divisors of one word, and divisors of many words.
+ * Burnikel-Ziegler and Newton division also run with low thresholds, so that they
+ * recurse on short operands, and bigint_reciprocal is checked by its definition.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_division()
+{
+    static const size_t division_lengths[][2] = {
+        {5, 9}, {9, 9}, {1, 1}, {40, 1}, {300, 1}, {100, 2}, {1000, 17}, {2000, 400}, {2401, 1200}, {3000, 1200}
+    };
+    size_t length_num = sizeof(division_lengths) / sizeof(division_lengths[0]);
+    size_t failed = 0;
+
+    failed += test_division("division_binary_long", bigint_division_binary_long, DIVISION_ALIAS_NONE, FALSE);
+
+    for (int alias = DIVISION_ALIAS_NONE; alias <= REMAINDER_IS_DIVISOR; alias++)
+    {
+        failed += test_division("division_word_long", bigint_division_word_long, (DivisionAlias)alias, FALSE);
+        failed += test_division("division", bigint_division, (DivisionAlias)alias, FALSE);
+        failed += test_division_random("division_word_long (long)", bigint_division_word_long, division_lengths, length_num, (DivisionAlias)alias);
+        failed += test_division_random("division (long)", bigint_division, division_lengths, length_num, (DivisionAlias)alias);
+    }
+
+    /* Burnikel-Ziegler with the default threshold, then down to the smallest one */
+    for (int alias = DIVISION_ALIAS_NONE; alias <= REMAINDER_IS_DIVISOR; alias++)
+    {
+        failed += test_division("division_burnikel_ziegler", bigint_division_burnikel_ziegler, (DivisionAlias)alias, FALSE);
+        failed += test_division_random("division_burnikel_ziegler (long)", bigint_division_burnikel_ziegler, division_lengths, length_num, (DivisionAlias)alias);
+    }
+    for (division_threshold = 2; division_threshold <= 5; division_threshold++)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "division_burnikel_ziegler (threshold %zu)", division_threshold);
+        failed += test_division(name, division_burnikel_ziegler_low, DIVISION_ALIAS_NONE, FALSE);
+        failed += test_division_random(name, division_burnikel_ziegler_low, division_lengths, length_num, QUOTIENT_IS_DIVIDEND);
+    }
+
+    /* Newton division, and bigint_division going through it with low Newton thresholds */
+    for (int alias = DIVISION_ALIAS_NONE; alias <= REMAINDER_IS_DIVISOR; alias++)
+    {
+        failed += test_division("division_newton", bigint_division_newton, (DivisionAlias)alias, FALSE);
+        failed += test_division_random("division_newton (long)", bigint_division_newton, division_lengths, length_num, (DivisionAlias)alias);
+    }
+    for (division_threshold = 4; division_threshold <= 16; division_threshold *= 2)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "division_newton (threshold %zu)", division_threshold);
+        failed += test_division(name, division_newton_low, DIVISION_ALIAS_NONE, FALSE);
+        failed += test_division_random(name, division_newton_low, division_lengths, length_num, REMAINDER_IS_DIVIDEND);
+        snprintf(name, sizeof(name), "division (Newton threshold %zu)", division_threshold);
+        failed += test_division_random(name, division_low_newton_threshold, division_lengths, length_num, QUOTIENT_IS_DIVISOR);
+    }
+
+    /* Reciprocal */
+    failed += test_reciprocal("reciprocal", (size_t)-1);
+    failed += test_reciprocal("reciprocal (Newton threshold 4)", 4);
+    failed += test_reciprocal("reciprocal (Newton threshold 7)", 7);
+
+    return failed;
+}
+
+/* Single-word operations as binary operations: the word is the only digit of y */
+static void addition_word(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_addition_word(result, operand_x, operand_y->digits[0]);
+}
+
+static void subtraction_word(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_subtraction_word(result, operand_x, operand_y->digits[0]);
+}
+
+static void multiplication_word(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_multiplication_word(result, operand_x, operand_y->digits[0]);
+}
+
+static void addition_word_inplace(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_copy(result, operand_x);
+    bigint_addition_word_inplace(result, operand_y->digits[0]);
+}
+
+static void subtraction_word_inplace(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_copy(result, operand_x);
+    bigint_subtraction_word_inplace(result, operand_y->digits[0]);
+}
+
+static void multiplication_word_inplace(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_copy(result, operand_x);
+    bigint_multiplication_word_inplace(result, operand_y->digits[0]);
+}
+
+/* Single-word divisions as divisions: the word remainder is the only digit of the remainder */
+static void set_word(Bigint** bigint, Word word)
+{
+    bigint_set_zero(bigint);
+    (*bigint)->digits[0] = word;
+}
+
+static void division_word(Bigint** quotient, Bigint** remainder, const Bigint* dividend, const Bigint* divisor)
+{
+    Word word = divisor->digits[0]; // before the quotient is written over the divisor
+    set_word(remainder, bigint_division_word(quotient, dividend, word));
+}
+
+static void division_word_inplace(Bigint** quotient, Bigint** remainder, const Bigint* dividend, const Bigint* divisor)
+{
+    Word word = divisor->digits[0];
+    bigint_copy(quotient, dividend);
+    set_word(remainder, bigint_division_word_inplace(quotient, word));
+}
+
+/* quotient by bigint_division_word, remainder by bigint_reduction_word */
+static void reduction_word(Bigint** quotient, Bigint** remainder, const Bigint* dividend, const Bigint* divisor)
+{
+    Word word = divisor->digits[0];
+    Word word_remainder = bigint_reduction_word(dividend, word);
+    bigint_division_word(quotient, dividend, word);
+    set_word(remainder, word_remainder);
+}
+
+/**
+ * @brief Checks a single-word operation on long random operands against the same operation on Bigints.
+ * 
+ * Besides random x, x is tried with all-one digits and as a power of W, so that the
+ * carry and the borrow run through every digit.
+ * 
+ * @param operation [input] Operation on x and the only digit of y.
+ * @param reference [input] Same operation on two Bigints.
+ * @return size_t Number of failed checks.
+ */
+static size_t test_word_operation_random(const char* name, BinaryOperation operation, BinaryOperation reference, Alias alias)
+{
+    static const size_t lengths[] = { 1, 2, 3, 40, 300 };
+    Bigint* operand_x = NULL;
+    Bigint* operand_y = NULL;
+    Bigint* result = NULL;
+    Bigint* expected = NULL;
+    size_t total = 0, failed = 0;
+    char full_name[96];
+
+    snprintf(full_name, sizeof(full_name), "%s (long)", name);
+
+    for (size_t idx = 0; idx < sizeof(lengths) / sizeof(lengths[0]); idx++)
+    {
+        for (int trial = 0; trial < RANDOM_TRIAL_NUM; trial++)
+        {
+            generate_random_operand(&operand_x, lengths[idx]);
+            bigint_generate_random_number(&operand_y, POSITIVE, 1);
+
+            if (trial == 1) {
+                for (size_t idx_digit = 0; idx_digit < lengths[idx]; idx_digit++)
+                    operand_x->digits[idx_digit] = (Word)-1;
+                operand_x->digit_num = lengths[idx];
+            } else if (trial == 2) {
+                bigint_new(&operand_x, lengths[idx] + 1);
+                operand_x->digits[lengths[idx]] = 1;
+                if (rand() & 1) operand_x->sign = NEGATIVE;
+            }
+
+            run_binary_operation(operation, &result, operand_x, operand_y, alias);
+            reference(&expected, operand_x, operand_y);
+
+            total++;
+            if (bigint_compare(result, expected) != SAME)
+                record_failure(full_name, &failed, operand_x, operand_y);
+        }
+    }
+
+    bigint_delete(&operand_x);
+    bigint_delete(&operand_y);
+    bigint_delete(&result);
+    bigint_delete(&expected);
+
+    return report(full_name, total, failed);
+}
+
+/**
+ * @brief Checks the operations with a single-word operand.
+ * 
+ * They are checked on the test vectors whose y fits into a word against the known results,
+ * with the result written to a new Bigint and over x, and in place. The word is positive,
+ * so x takes both signs, except for divisions. Long operands are checked against the
+ * operations on Bigints.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_word()
+{
+    static const size_t division_lengths[][2] = { {1, 1}, {2, 1}, {40, 1}, {300, 1}, {2000, 1} };
+    size_t length_num = sizeof(division_lengths) / sizeof(division_lengths[0]);
+    size_t failed = 0;
+
+    for (int alias = ALIAS_NONE; alias <= ALIAS_X; alias++)
+    {
+        const char* suffix = (alias == ALIAS_X) ? " (result is x)" : "";
+        char name[64];
+
+        snprintf(name, sizeof(name), "addition_word%s", suffix);
+        failed += test_binary_operation(name, addition_word, "add", SIGNS_PP | SIGNS_NP, (Alias)alias, TRUE);
+        failed += test_word_operation_random(name, addition_word, bigint_addition, (Alias)alias);
+        snprintf(name, sizeof(name), "subtraction_word%s", suffix);
+        failed += test_binary_operation(name, subtraction_word, "sub", SIGNS_PP | SIGNS_NP, (Alias)alias, TRUE);
+        failed += test_word_operation_random(name, subtraction_word, bigint_subtraction, (Alias)alias);
+        snprintf(name, sizeof(name), "multiplication_word%s", suffix);
+        failed += test_binary_operation(name, multiplication_word, "mul", SIGNS_PP | SIGNS_NP, (Alias)alias, TRUE);
+        failed += test_word_operation_random(name, multiplication_word, bigint_multiplication, (Alias)alias);
+    }
+
+    failed += test_binary_operation("addition_word_inplace", addition_word_inplace, "add", SIGNS_PP | SIGNS_NP, ALIAS_NONE, TRUE);
+    failed += test_word_operation_random("addition_word_inplace", addition_word_inplace, bigint_addition, ALIAS_NONE);
+    failed += test_binary_operation("subtraction_word_inplace", subtraction_word_inplace, "sub", SIGNS_PP | SIGNS_NP, ALIAS_NONE, TRUE);
+    failed += test_word_operation_random("subtraction_word_inplace", subtraction_word_inplace, bigint_subtraction, ALIAS_NONE);
+    failed += test_binary_operation("multiplication_word_inplace", multiplication_word_inplace, "mul", SIGNS_PP | SIGNS_NP, ALIAS_NONE, TRUE);
+    failed += test_word_operation_random("multiplication_word_inplace", multiplication_word_inplace, bigint_multiplication, ALIAS_NONE);
+
+    /* Divisions by a word: the quotient may be written over the dividend */
+    failed += test_division("division_word", division_word, DIVISION_ALIAS_NONE, TRUE);
+    failed += test_division("division_word", division_word, QUOTIENT_IS_DIVIDEND, TRUE);
+    failed += test_division_random("division_word (long)", division_word, division_lengths, length_num, DIVISION_ALIAS_NONE);
+    failed += test_division_random("division_word (long)", division_word, division_lengths, length_num, QUOTIENT_IS_DIVIDEND);
+    failed += test_division("division_word_inplace", division_word_inplace, DIVISION_ALIAS_NONE, TRUE);
+    failed += test_division_random("division_word_inplace (long)", division_word_inplace, division_lengths, length_num, DIVISION_ALIAS_NONE);
+    failed += test_division("reduction_word", reduction_word, DIVISION_ALIAS_NONE, TRUE);
+    failed += test_division_random("reduction_word (long)", reduction_word, division_lengths, length_num, DIVISION_ALIAS_NONE);
+
+    return failed;
+}
+
+/* In-place operations as binary operations on a copy of x */
+static void addition_inplace(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_copy(result, operand_x);
+    bigint_addition_inplace(result, operand_y);
+}
+
+static void subtraction_inplace(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_copy(result, operand_x);
+    bigint_subtraction_inplace(result, operand_y);
+}
+
+static void addition_unsigned_inplace(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_copy(result, operand_x);
+    bigint_addition_unsigned_inplace(result, operand_y);
+}
+
+static void subtraction_unsigned_inplace(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_copy(result, operand_x);
+    bigint_subtraction_unsigned_inplace(result, operand_y);
+}
+
+/* | |x| - |y| | with the sign of x, which bigint_subtraction_unsigned_inplace gives */
+static void subtraction_of_absolute_values(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    Bigint absolute_x = bigint_view(operand_x->digits, operand_x->digit_num, POSITIVE);
+    Bigint absolute_y = bigint_view(operand_y->digits, operand_y->digit_num, POSITIVE);
+
+    if (bigint_compare(&absolute_x, &absolute_y) == LEFT_IS_SMALL)
+        bigint_subtraction(result, &absolute_y, &absolute_x);
+    else
+        bigint_subtraction(result, &absolute_x, &absolute_y);
+
+    if (bigint_is_zero(*result) == FALSE) (*result)->sign = operand_x->sign;
+}
+
+/**
+ * @brief Checks x += x and x -= x on every x of the test vectors and on random operands.
+ * 
+ * @return size_t Number of failed checks.
+ */
+static size_t test_inplace_self(const char* name)
+{
+    static const size_t lengths[] = { 1, 2, 40, 300 };
+    Bigint* operand = NULL;
+    Bigint* operand_copy = NULL;
+    Bigint* result = NULL;
+    Bigint* expected = NULL;
+    size_t length_num = sizeof(lengths) / sizeof(lengths[0]);
+    size_t total = 0, failed = 0;
+    FILE* f_operand_x = open_file(OPERAND_X_FILE_PATH);
+
+    for (size_t idx = 0; idx < TEST_VECTOR_NUM + length_num * RANDOM_TRIAL_NUM; idx++)
+    {
+        if (idx < TEST_VECTOR_NUM)
+            read_integer_from_file(&operand, f_operand_x);
+        else
+            generate_random_operand(&operand, lengths[(idx - TEST_VECTOR_NUM) / RANDOM_TRIAL_NUM]);
+
+        /* x += x */
+        bigint_copy(&operand_copy, operand);
+        bigint_addition(&expected, operand, operand_copy);
+        bigint_copy(&result, operand);
+        bigint_addition_inplace(&result, result);
+        total++;
+        if (bigint_compare(result, expected) != SAME)
+            record_failure(name, &failed, operand, NULL);
+
+        /* x -= x */
+        bigint_copy(&result, operand);
+        bigint_subtraction_inplace(&result, result);
+        total++;
+        if (bigint_is_zero(result) == FALSE || result->sign != POSITIVE)
+            record_failure(name, &failed, operand, NULL);
+    }
+
+    fclose(f_operand_x);
+    bigint_delete(&operand);
+    bigint_delete(&operand_copy);
+    bigint_delete(&result);
+    bigint_delete(&expected);
+
+    return report(name, total, failed);
+}
+
+/**
+ * @brief Checks the in-place shifts on every x of the test vectors and on random operands.
+ * 
+ * x << k is compared with x * 2^k, and |x| >> k with |x| / 2^k, for shifts within a word,
+ * of whole words and across words.
+ * 
+ * @return size_t Number of failed checks.
+ */
+static size_t test_shift_inplace(const char* name)
+{
+    static const size_t lengths[] = { 1, 2, 40, 300 };
+    const size_t bit_counts[] = { 0, 1, 7, BITLEN_OF_WORD - 1, BITLEN_OF_WORD, BITLEN_OF_WORD + 1, 3 * BITLEN_OF_WORD + 5 };
+    Bigint* operand = NULL;
+    Bigint* power = NULL;
+    Bigint* result = NULL;
+    Bigint* expected = NULL;
+    Bigint* remainder = NULL;
+    size_t length_num = sizeof(lengths) / sizeof(lengths[0]);
+    size_t total = 0, failed = 0;
+    FILE* f_operand_x = open_file(OPERAND_X_FILE_PATH);
+
+    for (size_t idx = 0; idx < TEST_VECTOR_NUM + length_num * RANDOM_TRIAL_NUM; idx++)
+    {
+        if (idx < TEST_VECTOR_NUM)
+            read_integer_from_file(&operand, f_operand_x);
+        else
+            generate_random_operand(&operand, lengths[(idx - TEST_VECTOR_NUM) / RANDOM_TRIAL_NUM]);
+        if (idx % 2 == 1 && bigint_is_zero(operand) == FALSE) operand->sign = NEGATIVE;
+
+        for (size_t idx_count = 0; idx_count < sizeof(bit_counts) / sizeof(bit_counts[0]); idx_count++)
+        {
+            size_t bit_count = bit_counts[idx_count];
+
+            /* 2^k */
+            bigint_new(&power, bit_count / BITLEN_OF_WORD + 1);
+            power->digits[bit_count / BITLEN_OF_WORD] = (Word)1 << (bit_count % BITLEN_OF_WORD);
+
+            /* x << k */
+            multiplication_reference(&expected, operand, power);
+            bigint_copy(&result, operand);
+            bigint_shift_left_inplace(&result, bit_count);
+            total++;
+            if (bigint_compare(result, expected) != SAME)
+                record_failure(name, &failed, operand, power);
+
+            /* |x| >> k */
+            bigint_copy(&result, operand);
+            result->sign = POSITIVE;
+            bigint_division(&expected, &remainder, result, power);
+            bigint_shift_right_inplace(&result, bit_count);
+            total++;
+            if (bigint_compare(result, expected) != SAME)
+                record_failure(name, &failed, operand, power);
+        }
+    }
+
+    fclose(f_operand_x);
+    bigint_delete(&operand);
+    bigint_delete(&power);
+    bigint_delete(&result);
+    bigint_delete(&expected);
+    bigint_delete(&remainder);
+
+    return report(name, total, failed);
+}
+
+/**
+ * @brief Checks Barrett reduction, out of place, over the operand and in place, against the remainder of bigint_division.
+ * 
+ * For moduli of every length, the operand is shorter than the modulus, as long as it,
+ * one digit shorter than its square, or as long as its square.
+ * 
+ * @return size_t Number of failed checks.
+ */
+static size_t test_barrett(const char* name)
+{
+    static const size_t lengths[] = { 1, 2, 3, 5, 40, 300 };
+    Bigint* modular = NULL;
+    Bigint* pre_computed = NULL;
+    Bigint* operand = NULL;
+    Bigint* result = NULL;
+    Bigint* quotient = NULL;
+    Bigint* expected = NULL;
+    size_t total = 0, failed = 0;
+
+    for (size_t idx = 0; idx < sizeof(lengths) / sizeof(lengths[0]); idx++)
+    {
+        size_t length = lengths[idx];
+        size_t operand_lengths[] = { (length > 1) ? length - 1 : 1, length, 2 * length - 1, 2 * length };
+
+        for (int trial = 0; trial < RANDOM_TRIAL_NUM; trial++)
+        {
+            bigint_generate_random_number(&modular, POSITIVE, length);
+            if (trial == 1) bigint_shift_right_inplace(&modular, 1); // a top bit that is not set
+            if (bigint_is_zero(modular) == TRUE) bigint_set_one(&modular);
+            bigint_reduction_barrett_pre_computed(&pre_computed, modular);
+
+            for (size_t idx_operand = 0; idx_operand < sizeof(operand_lengths) / sizeof(operand_lengths[0]); idx_operand++)
+            {
+                bigint_generate_random_number(&operand, POSITIVE, operand_lengths[idx_operand]);
+                bigint_refine(operand);
+                if (operand->digit_num > 2 * modular->digit_num) // the top digits of the modulus were zero
+                    bigint_compress(&operand, operand, operand->digit_num - 2 * modular->digit_num);
+                bigint_division(&quotient, &expected, operand, modular);
+
+                /* A mod N */
+                bigint_reduction_barrett(&result, operand, modular, pre_computed);
+                total++;
+                if (bigint_compare(result, expected) != SAME)
+                    record_failure(name, &failed, operand, modular);
+
+                /* A <- A mod N, over the operand and in place */
+                bigint_copy(&result, operand);
+                bigint_reduction_barrett(&result, result, modular, pre_computed);
+                total++;
+                if (bigint_compare(result, expected) != SAME)
+                    record_failure(name, &failed, operand, modular);
+
+                bigint_copy(&result, operand);
+                bigint_reduction_barrett_inplace(&result, modular, pre_computed);
+                total++;
+                if (bigint_compare(result, expected) != SAME)
+                    record_failure(name, &failed, operand, modular);
+            }
+        }
+    }
+
+    bigint_delete(&modular);
+    bigint_delete(&pre_computed);
+    bigint_delete(&operand);
+    bigint_delete(&result);
+    bigint_delete(&quotient);
+    bigint_delete(&expected);
+
+    return report(name, total, failed);
+}
+
+/**
+ * @brief Checks the in-place operations: x += y, x -= y, x <<= k, x >>= k and x = x mod N.
+ * 
+ * Addition and subtraction are checked on the test vectors against the known results,
+ * on long operands of unequal lengths against the out-of-place operations, and with
+ * y being x itself.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_inplace()
+{
+    static const size_t lengths[][2] = { {1, 1}, {1, 40}, {40, 1}, {40, 40}, {300, 299}, {299, 300} };
+    size_t length_num = sizeof(lengths) / sizeof(lengths[0]);
+    size_t failed = 0;
+
+    failed += test_binary_operation("addition_inplace", addition_inplace, "add", SIGNS_ALL, ALIAS_NONE, FALSE);
+    failed += test_binary_operation_random("addition_inplace (long)", addition_inplace, bigint_addition, lengths, length_num, ALIAS_NONE);
+    failed += test_binary_operation("subtraction_inplace", subtraction_inplace, "sub", SIGNS_ALL, ALIAS_NONE, FALSE);
+    failed += test_binary_operation_random("subtraction_inplace (long)", subtraction_inplace, bigint_subtraction, lengths, length_num, ALIAS_NONE);
+    failed += test_binary_operation("addition_unsigned_inplace", addition_unsigned_inplace, "add", SIGNS_PP, ALIAS_NONE, FALSE);
+    failed += test_binary_operation_random("subtraction_unsigned_inplace (long)", subtraction_unsigned_inplace, subtraction_of_absolute_values, lengths, length_num, ALIAS_NONE);
+    failed += test_inplace_self("addition_inplace and subtraction_inplace (x with itself)");
+
+    failed += test_shift_inplace("shift_left_inplace and shift_right_inplace");
+    failed += test_barrett("reduction_barrett and reduction_barrett_inplace");
+
+    return failed;
+}
+
+static void squaring_of_x(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    (void)operand_y;
+    bigint_squaring(result, operand_x);
+}
+
+static void quotient_of_division(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    Bigint* remainder = NULL;
+    bigint_division(result, &remainder, operand_x, operand_y);
+    bigint_delete(&remainder);
+}
+
+static void remainder_of_division(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    Bigint* quotient = NULL;
+    bigint_division(&quotient, result, operand_x, operand_y);
+    bigint_delete(&quotient);
+}
+
+/**
+ * @brief Checks bigint_view_part and bigint_view against bigint_copy_part on random integers.
+ * 
+ * The parts cover the whole integer, the empty part, and parts above the most significant digit.
+ * 
+ * @return size_t Number of failed checks.
+ */
+static size_t test_view_part(const char* name)
+{
+    static const size_t lengths[] = { 1, 2, 5, 40, 300 };
+    Bigint* bigint = NULL;
+    Bigint* expected = NULL;
+    size_t total = 0, failed = 0;
+
+    for (size_t idx = 0; idx < sizeof(lengths) / sizeof(lengths[0]); idx++)
+    {
+        for (int trial = 0; trial < RANDOM_TRIAL_NUM * 10; trial++)
+        {
+            size_t length = lengths[idx];
+            generate_random_operand(&bigint, length);
+
+            /* [start, end) within 0 ~ length + 2 */
+            size_t offset_start = (size_t)rand() % (length + 3);
+            size_t offset_end = (size_t)rand() % (length + 3);
+            if (trial == 0) { offset_start = 0; offset_end = length; }
+            if (offset_start > offset_end) { size_t tmp = offset_start; offset_start = offset_end; offset_end = tmp; }
+
+            Bigint view = bigint_view_part(bigint, offset_start, offset_end);
+
+            size_t copy_end = (offset_end < bigint->digit_num) ? offset_end : bigint->digit_num;
+            size_t copy_start = (offset_start < copy_end) ? offset_start : copy_end;
+            if (copy_start == copy_end)
+                bigint_set_zero(&expected);
+            else
+                bigint_copy_part(&expected, bigint, copy_start, copy_end);
+
+            total++;
+            if (bigint_compare(&view, expected) != SAME || view.sign != POSITIVE)
+                record_failure(name, &failed, bigint, NULL);
+
+            /* A view of all digits keeps the sign */
+            view = bigint_view(bigint->digits, bigint->digit_num, bigint->sign);
+            total++;
+            if (bigint_compare(&view, bigint) != SAME)
+                record_failure(name, &failed, bigint, NULL);
+        }
+    }
+
+    bigint_delete(&bigint);
+    bigint_delete(&expected);
+
+    return report(name, total, failed);
+}
+
+/**
+ * @brief Checks an operation on two views of the parts of one integer.
+ * 
+ * x is split into a low and a high part. The operation is run on views of the parts,
+ * then with its result written over x itself, so that the output shares the digits of
+ * both operands, and both are compared with the operation on copies of the parts.
+ * 
+ * @param operation [input] Operation to check, on (high, low).
+ * @return size_t Number of failed checks.
+ */
+static size_t test_view_operation(const char* name, BinaryOperation operation)
+{
+    static const size_t lengths[][2] = { {1, 1}, {2, 1}, {3, 3}, {40, 13}, {300, 300}, {700, 100}, {1200, 1200} };
+    Bigint* bigint = NULL;
+    Bigint* high = NULL;
+    Bigint* low = NULL;
+    Bigint* result = NULL;
+    Bigint* expected = NULL;
+    size_t total = 0, failed = 0;
+
+    for (size_t idx = 0; idx < sizeof(lengths) / sizeof(lengths[0]); idx++)
+    {
+        for (int trial = 0; trial < RANDOM_TRIAL_NUM; trial++)
+        {
+            size_t length_high = lengths[idx][0];
+            size_t length_low = lengths[idx][1];
+
+            bigint_generate_random_number(&bigint, POSITIVE, length_high + length_low);
+            bigint->digits[0] |= 1; // the low part is a non-zero divisor
+            bigint->digits[length_high + length_low - 1] |= 1;
+            bigint->digit_num = length_high + length_low;
+            bigint_copy_part(&low, bigint, 0, length_low);
+            bigint_copy_part(&high, bigint, length_low, length_high + length_low);
+            operation(&expected, high, low);
+
+            /* views of x */
+            Bigint view_high = bigint_view_part(bigint, length_low, length_high + length_low);
+            Bigint view_low = bigint_view_part(bigint, 0, length_low);
+            operation(&result, &view_high, &view_low);
+            total++;
+            if (bigint_compare(result, expected) != SAME)
+                record_failure(name, &failed, high, low);
+
+            /* x <- op(views of x) */
+            operation(&bigint, &view_high, &view_low);
+            total++;
+            if (bigint_compare(bigint, expected) != SAME)
+                record_failure(name, &failed, high, low);
+        }
+    }
+
+    bigint_delete(&bigint);
+    bigint_delete(&high);
+    bigint_delete(&low);
+    bigint_delete(&result);
+    bigint_delete(&expected);
+
+    return report(name, total, failed);
+}
+
+/**
+ * @brief Checks the zero-copy views, as parts of integers and as operands.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_view()
+{
+    size_t failed = 0;
+
+    failed += test_view_part("view_part and view");
+    failed += test_view_operation("addition (views)", bigint_addition);
+    failed += test_view_operation("subtraction (views)", bigint_subtraction);
+    failed += test_view_operation("multiplication (views)", bigint_multiplication);
+    failed += test_view_operation("multiplication (views, low thresholds)", multiplication_low_thresholds);
+    failed += test_view_operation("squaring (views)", squaring_of_x);
+    failed += test_view_operation("division quotient (views)", quotient_of_division);
+    failed += test_view_operation("division remainder (views)", remainder_of_division);
+
+    return failed;
+}
+
+static void squaring_of_x_low_thresholds(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    (void)operand_y;
+    squaring_low_thresholds(result, operand_x);
+}
+
+/* Division with low Burnikel-Ziegler and Newton thresholds, quotient only */
+static void quotient_of_division_low_thresholds(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    Thresholds thresholds, low;
+
+    bigint_get_thresholds(&thresholds);
+    low = thresholds;
+    low.burnikel_ziegler = 4;
+    low.newton = 8;
+
+    bigint_set_thresholds(&low);
+    quotient_of_division(result, operand_x, operand_y);
+    bigint_set_thresholds(&thresholds);
+}
+
+/**
+ * @brief Checks that an operation releases all of its temporaries in the scratch arena.
+ * 
+ * The mark of the arena is compared before and after the operation on random operands
+ * of the given lengths, with the result in a new Bigint and over x.
+ * 
+ * @param lengths [input] Pairs of lengths of x and y in digits.
+ * @param length_num [input] Number of pairs.
+ * @return size_t Number of failed checks.
+ */
+static size_t test_scratch_operation(const char* name, BinaryOperation operation, const size_t (*lengths)[2], size_t length_num)
+{
+    Bigint* operand_x = NULL;
+    Bigint* operand_y = NULL;
+    Bigint* result = NULL;
+    size_t total = 0, failed = 0;
+
+    for (size_t idx = 0; idx < length_num; idx++)
+    {
+        bigint_generate_random_number(&operand_x, POSITIVE, lengths[idx][0]);
+        bigint_generate_random_number(&operand_y, POSITIVE, lengths[idx][1]);
+        if (bigint_is_zero(operand_y) == TRUE) bigint_set_one(&operand_y);
+
+        for (int alias = ALIAS_NONE; alias <= ALIAS_X; alias++)
+        {
+            ScratchMark before = bigint_scratch_mark();
+            run_binary_operation(operation, &result, operand_x, operand_y, (Alias)alias);
+            ScratchMark after = bigint_scratch_mark();
+
+            total++;
+            if (after.in_use != before.in_use || after.chunk != before.chunk || after.top != before.top || result->storage != STORAGE_HEAP)
+                record_failure(name, &failed, operand_x, operand_y);
+        }
+    }
+
+    bigint_delete(&operand_x);
+    bigint_delete(&operand_y);
+    bigint_delete(&result);
+
+    return report(name, total, failed);
+}
+
+/**
+ * @brief Checks temporaries of the scratch arena: their storage, growing to the heap, and release.
+ * 
+ * @return size_t Number of failed checks.
+ */
+static size_t test_scratch_temporaries(const char* name)
+{
+    size_t total = 0, failed = 0;
+
+    for (size_t digit_num = 1; digit_num <= 4096; digit_num *= 8)
+    {
+        Bigint* small = NULL;
+        Bigint* large = NULL;
+        ScratchMark mark = bigint_scratch_mark();
+
+        bigint_scratch_new(&small, digit_num);
+        bigint_scratch_new(&large, SCRATCH_CHUNK_SIZE / SIZE_OF_WORD * 2); // larger than a chunk
+        small->digits[digit_num - 1] = 1;
+
+        /* Carved from the arena, zero-filled, in use until the release */
+        total++;
+        if (small->storage != STORAGE_SCRATCH || large->storage != STORAGE_SCRATCH || large->digits[0] != 0 ||
+            small->digit_num != digit_num || bigint_scratch_mark().in_use <= mark.in_use || bigint_scratch_high_water_mark() < bigint_scratch_mark().in_use)
+            record_failure(name, &failed, small, NULL);
+
+        /* A temporary that grows moves to the heap with its digits */
+        bigint_resize(&small, small->capacity + 1);
+        total++;
+        if (small->storage != STORAGE_HEAP || small->digits[digit_num - 1] != 1)
+            record_failure(name, &failed, small, NULL);
+
+        bigint_delete(&small);
+        bigint_delete(&large);
+        bigint_scratch_release(mark);
+
+        total++;
+        if (bigint_scratch_mark().in_use != mark.in_use)
+            failed++;
+    }
+
+    return report(name, total, failed);
+}
+
+/**
+ * @brief Checks the scratch arena: every routine releases its temporaries.
+ * 
+ * The routines run with lengths that make them recurse (Karatsuba, Toom-Cook, the NTT,
+ * Burnikel-Ziegler and Newton), so that their temporaries are nested.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_scratch()
+{
+    static const size_t lengths[][2] = { {1, 1}, {40, 40}, {300, 7}, {700, 700}, {3000, 1000} };
+    static const size_t division_lengths[][2] = { {1, 1}, {40, 1}, {300, 100}, {2000, 400}, {3000, 1200} };
+    size_t length_num = sizeof(lengths) / sizeof(lengths[0]);
+    size_t failed = 0;
+
+    failed += test_scratch_temporaries("scratch_new and scratch_release");
+    failed += test_scratch_operation("addition (scratch)", bigint_addition, lengths, length_num);
+    failed += test_scratch_operation("subtraction (scratch)", bigint_subtraction, lengths, length_num);
+    failed += test_scratch_operation("multiplication (scratch)", bigint_multiplication, lengths, length_num);
+    failed += test_scratch_operation("multiplication (scratch, low thresholds)", multiplication_low_thresholds, lengths, length_num);
+    failed += test_scratch_operation("squaring (scratch)", squaring_of_x, lengths, length_num);
+    failed += test_scratch_operation("squaring (scratch, low thresholds)", squaring_of_x_low_thresholds, lengths, length_num);
+    failed += test_scratch_operation("division (scratch)", quotient_of_division, division_lengths, length_num);
+    failed += test_scratch_operation("division (scratch, low thresholds)", quotient_of_division_low_thresholds, division_lengths, length_num);
+
+    return failed;
+}
+
+#define ALLOCATION_TRACK_NUM 4096 ///< Blocks the counting allocator can track at once.
+
+/* Allocator hooks that count the blocks and check the sizes given back to them */
+typedef struct {
+    void* memory[ALLOCATION_TRACK_NUM];
+    size_t size[ALLOCATION_TRACK_NUM];
+    size_t live;        ///< Blocks allocated and not freed.
+    size_t allocations; ///< Calls of the allocation hook.
+    size_t reallocations; ///< Calls of the reallocation hook.
+    size_t errors;      ///< Wrong sizes, alignments or pointers.
+} AllocationCounter;
+
+static void* aligned_memory_allocate(size_t size, size_t alignment)
+{
+#if defined(_WIN32)
+    return _aligned_malloc(size, alignment);
+#else
+    return aligned_alloc(alignment, size);
+#endif
+}
+
+static void aligned_memory_free(void* memory)
+{
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+/* find the slot of a block: NULL finds a free slot */
+static size_t counter_find(const AllocationCounter* counter, const void* memory)
+{
+    for (size_t idx = 0; idx < ALLOCATION_TRACK_NUM; idx++)
+        if (counter->memory[idx] == memory) return idx;
+
+    return ALLOCATION_TRACK_NUM;
+}
+
+static void* counting_alloc(size_t size, size_t alignment, void* context)
+{
+    AllocationCounter* counter = (AllocationCounter*)context;
+    size_t idx = counter_find(counter, NULL);
+
+    counter->allocations++;
+    if (alignment != BIGINT_ALIGNMENT || size % alignment != 0 || idx == ALLOCATION_TRACK_NUM) {
+        counter->errors++;
+        return NULL;
+    }
+
+    void* memory = aligned_memory_allocate(size, alignment);
+    if (memory == NULL) return NULL;
+
+    counter->memory[idx] = memory;
+    counter->size[idx] = size;
+    counter->live++;
+
+    return memory;
+}
+
+static void counting_free(void* memory, size_t size, void* context)
+{
+    AllocationCounter* counter = (AllocationCounter*)context;
+    size_t idx = counter_find(counter, memory);
+
+    if (memory == NULL || idx == ALLOCATION_TRACK_NUM || counter->size[idx] != size) {
+        counter->errors++;
+        return; // not ours: leak rather than free memory of another allocator
+    }
+
+    counter->memory[idx] = NULL;
+    counter->live--;
+    aligned_memory_free(memory);
+}
+
+static void* counting_realloc(void* memory, size_t old_size, size_t new_size, size_t alignment, void* context)
+{
+    AllocationCounter* counter = (AllocationCounter*)context;
+
+    counter->reallocations++;
+    counter->allocations--; // counted as a reallocation only
+
+    void* new_memory = counting_alloc(new_size, alignment, context);
+    if (new_memory == NULL) return NULL;
+
+    memcpy(new_memory, memory, (old_size < new_size) ? old_size : new_size);
+    counting_free(memory, old_size, context);
+
+    return new_memory;
+}
+
+/* allocate, grow, compute with temporaries in the arena, then free everything */
+static void exercise_allocator(void)
+{
+    Bigint* operand_x = NULL;
+    Bigint* operand_y = NULL;
+    Bigint* result = NULL;
+    Bigint* remainder = NULL;
+
+    bigint_generate_random_number(&operand_x, POSITIVE, 3000);
+    bigint_generate_random_number(&operand_y, NEGATIVE, 1200);
+    operand_y->digits[operand_y->digit_num - 1] |= 1;
+
+    /* Growing a small Bigint one digit at a time */
+    bigint_new(&result, 1);
+    for (size_t digit_num = 2; digit_num <= 100; digit_num++)
+        bigint_resize(&result, digit_num);
+
+    multiplication_low_thresholds(&result, operand_x, operand_y);
+    bigint_multiplication(&result, operand_x, operand_y);
+    bigint_squaring(&result, result);
+
+    operand_y->sign = POSITIVE;
+    quotient_of_division_low_thresholds(&result, operand_x, operand_y);
+    bigint_division(&result, &remainder, operand_x, operand_y);
+
+    bigint_delete(&operand_x);
+    bigint_delete(&operand_y);
+    bigint_delete(&result);
+    bigint_delete(&remainder);
+}
+
+/**
+ * @brief Checks that all memory goes through the allocator hooks with the sizes it was allocated with.
+ * 
+ * The hooks are set after the scratch arena is freed, so that no memory of the default
+ * allocator is left. After the Bigints are deleted and the arena is freed again, no block
+ * may be left, also with the default reallocation hook. A cached chunk of the arena large
+ * enough for a temporary must be reused even if a smaller one comes first, and a reserve
+ * of an unaligned size must reach the hooks aligned. Then multiplication, squaring and
+ * division are repeated into results of the right capacity after the arena is reserved,
+ * which must not allocate at all.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_allocator()
+{
+    static AllocationCounter counter; // too large for the stack
+    const char* name = "allocator hooks";
+    size_t total = 0, failed = 0;
+
+    for (int default_realloc = FALSE; default_realloc <= TRUE; default_realloc++)
+    {
+        memset(&counter, 0, sizeof(counter));
+
+        bigint_scratch_free();
+        bigint_set_allocator(counting_alloc, (default_realloc == TRUE) ? NULL : counting_realloc, counting_free, &counter);
+        exercise_allocator();
+        bigint_scratch_free();
+        bigint_set_allocator(NULL, NULL, NULL, NULL);
+
+        total++;
+        if (counter.live != 0 || counter.errors != 0 || counter.allocations == 0 ||
+            (default_realloc == FALSE && counter.reallocations == 0)) {
+            printf("%s failed: %zu blocks left, %zu errors\n", name, counter.live, counter.errors);
+            failed++;
+        }
+    }
+
+    /* Cached chunks: the first one large enough is reused, and only the smaller ones before it are freed */
+    {
+        Bigint* first = NULL;
+        Bigint* second = NULL;
+        Bigint* third = NULL;
+        size_t chunk_digit_num = SCRATCH_CHUNK_SIZE / SIZE_OF_WORD;
+
+        memset(&counter, 0, sizeof(counter));
+        bigint_scratch_free();
+        bigint_set_allocator(counting_alloc, counting_realloc, counting_free, &counter);
+
+        /* Three chunks, then back to the first one */
+        ScratchMark mark = bigint_scratch_mark();
+        bigint_scratch_new(&first, chunk_digit_num * 3 / 4);
+        bigint_scratch_new(&second, chunk_digit_num * 3 / 2);
+        bigint_scratch_new(&third, chunk_digit_num * 4);
+        bigint_scratch_release(mark);
+
+        size_t allocations = counter.allocations;
+        size_t live = counter.live;
+
+        /* Too large for the rest of the first chunk and for the second, not for the third */
+        bigint_scratch_new(&first, chunk_digit_num * 3 / 4);
+        bigint_scratch_new(&third, chunk_digit_num * 3);
+
+        total++;
+        if (third->storage != STORAGE_SCRATCH || counter.allocations != allocations || counter.live != live - 1) {
+            printf("%s failed: cached chunk not reused (%zu allocations, %zu blocks freed)\n",
+                   name, counter.allocations - allocations, live - counter.live);
+            failed++;
+        }
+
+        bigint_scratch_release(mark);
+        bigint_scratch_free();
+        bigint_set_allocator(NULL, NULL, NULL, NULL);
+
+        total++;
+        if (counter.live != 0 || counter.errors != 0)
+            failed++;
+    }
+
+    /* A reserve of any size reaches the hooks as a multiple of the alignment */
+    memset(&counter, 0, sizeof(counter));
+    bigint_scratch_free();
+    bigint_set_allocator(counting_alloc, counting_realloc, counting_free, &counter);
+    bigint_scratch_reserve(SCRATCH_CHUNK_SIZE * 3 + 1);
+    bigint_scratch_free();
+    bigint_set_allocator(NULL, NULL, NULL, NULL);
+
+    total++;
+    if (counter.allocations != 1 || counter.live != 0 || counter.errors != 0) {
+        printf("%s failed: %zu errors reserving an unaligned size\n", name, counter.errors);
+        failed++;
+    }
+
+    /* Steady state: no allocation */
+    static const size_t lengths[] = { 10, 100, 300, 1000, 3000 };
+    Bigint* operand_x = NULL;
+    Bigint* operand_y = NULL;
+    Bigint* quotient = NULL;
+    Bigint* remainder = NULL;
+
+    for (size_t idx = 0; idx < sizeof(lengths) / sizeof(lengths[0]); idx++)
+    {
+        bigint_generate_random_number(&operand_x, POSITIVE, lengths[idx] * 2);
+        bigint_generate_random_number(&operand_y, POSITIVE, lengths[idx]);
+        bigint_set_zero(&quotient);
+        bigint_set_zero(&remainder);
+
+        for (int run = 0; run < 2; run++)
+        {
+            /* The first run sizes the results and the arena */
+            if (run == 1) {
+                bigint_scratch_reserve(bigint_scratch_high_water_mark());
+                memset(&counter, 0, sizeof(counter));
+                bigint_set_allocator(counting_alloc, counting_realloc, counting_free, &counter);
+            }
+
+            bigint_multiplication(&quotient, operand_x, operand_y);
+            bigint_squaring(&quotient, operand_x);
+            bigint_division(&quotient, &remainder, operand_x, operand_y);
+        }
+        bigint_set_allocator(NULL, NULL, NULL, NULL);
+
+        total++;
+        if (counter.allocations != 0 || counter.reallocations != 0 || counter.errors != 0) {
+            printf("%s failed: %zu allocations in steady state (%zu digits)\n", name, counter.allocations + counter.reallocations, lengths[idx]);
+            failed++;
+        }
+    }
+
+    bigint_delete(&operand_x);
+    bigint_delete(&operand_y);
+    bigint_delete(&quotient);
+    bigint_delete(&remainder);
+
+    return report(name, total, failed);
+}
+
+/**
+ * @brief Checks the result handoff: bigint_is_aliased, bigint_output_new, bigint_output_finish and bigint_swap.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_handoff()
+{
+    const char* name = "is_aliased, output_new, output_finish and swap";
+    Bigint* bigint = NULL;
+    Bigint* other = NULL;
+    Bigint* result = NULL;
+    Bigint* tmp_result = NULL;
+    size_t total = 0, failed = 0;
+
+    bigint_generate_random_number(&bigint, POSITIVE, 8);
+    bigint->digits[7] |= 1;
+    bigint->digit_num = 8;
+    bigint_generate_random_number(&other, NEGATIVE, 8);
+    bigint_refine(other);
+
+    /* Aliasing: the same Bigint, a view of its digits, but not another Bigint or NULL */
+    Bigint view = bigint_view_part(bigint, 2, 5);
+    Bigint view_of_other = bigint_view_part(other, 0, 8);
+    char expected_aliasing[][2] = {
+        { bigint_is_aliased(bigint, bigint), TRUE },
+        { bigint_is_aliased(bigint, &view), TRUE },
+        { bigint_is_aliased(bigint, &view_of_other), FALSE },
+        { bigint_is_aliased(bigint, other), FALSE },
+        { bigint_is_aliased(NULL, bigint), FALSE },
+        { bigint_is_aliased(bigint, NULL), FALSE },
+    };
+    for (size_t idx = 0; idx < sizeof(expected_aliasing) / sizeof(expected_aliasing[0]); idx++)
+    {
+        total++;
+        if (expected_aliasing[idx][0] != expected_aliasing[idx][1])
+            record_failure(name, &failed, bigint, other);
+    }
+
+    /* Not aliased: the output is the result itself */
+    ScratchMark mark = bigint_scratch_mark();
+    Bigint** output = bigint_output_new(&result, &tmp_result, 8, bigint, other);
+    bigint_copy(output, other);
+    bigint_output_finish(&result, &tmp_result);
+    bigint_scratch_release(mark);
+
+    total++;
+    if (output != &result || tmp_result != NULL || bigint_compare(result, other) != SAME)
+        record_failure(name, &failed, bigint, other);
+
+    /* Aliased: the output is a temporary, copied into the result by bigint_output_finish */
+    bigint_copy(&result, bigint);
+    mark = bigint_scratch_mark();
+    output = bigint_output_new(&result, &tmp_result, 8, result, other);
+    (*output)->digits[0] = result->digits[0] + 1; // the operand is still intact
+    (*output)->digit_num = 1;
+    Word expected_digit = bigint->digits[0] + 1;
+    total++;
+    if (output != &tmp_result || tmp_result->storage != STORAGE_SCRATCH || bigint_compare(result, bigint) != SAME)
+        record_failure(name, &failed, bigint, other);
+    bigint_output_finish(&result, &tmp_result);
+    bigint_scratch_release(mark);
+
+    total++;
+    if (tmp_result != NULL || result->digit_num != 1 || result->digits[0] != expected_digit || result->storage != STORAGE_HEAP)
+        record_failure(name, &failed, bigint, other);
+
+    /* Swap exchanges the pointers */
+    Bigint* bigint_before = bigint;
+    Bigint* other_before = other;
+    bigint_swap(&bigint, &other);
+    total++;
+    if (bigint != other_before || other != bigint_before)
+        record_failure(name, &failed, bigint, other);
+
+    bigint_delete(&bigint);
+    bigint_delete(&other);
+    bigint_delete(&result);
+
+    return report(name, total, failed);
+}
+
+/* write a file of thresholds */
+static void write_thresholds_file(const char* contents)
+{
+    FILE* file = fopen(THRESHOLDS_FILE_PATH, "w");
+
+    if (file == NULL) {
+        perror(THRESHOLDS_FILE_PATH);
+        exit(1);
+    }
+
+    fputs(contents, file);
+    fclose(file);
+}
+
+/**
+ * @brief Checks bigint_save_thresholds and bigint_load_thresholds, and the checks of bigint_set_thresholds.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_thresholds()
+{
+    const char* name = "save_thresholds and load_thresholds";
+    Thresholds original, custom, loaded;
+    size_t total = 0, failed = 0;
+    char contents[128];
+
+    bigint_get_thresholds(&original);
+
+    /* Every field round-trips */
+    size_t* fields = (size_t*)&custom;
+    for (size_t idx = 0; idx < sizeof(Thresholds) / sizeof(size_t); idx++)
+        fields[idx] = 100 + idx;
+    bigint_set_thresholds(&custom);
+    char saved = bigint_save_thresholds(THRESHOLDS_FILE_PATH);
+    bigint_set_thresholds(NULL);
+    char loaded_saved = bigint_load_thresholds(THRESHOLDS_FILE_PATH);
+    bigint_get_thresholds(&loaded);
+    total++;
+    if (saved != TRUE || loaded_saved != TRUE || memcmp(&loaded, &custom, sizeof(Thresholds)) != 0)
+        failed++;
+
+    /* Comments are skipped, and missing thresholds keep their values */
+    write_thresholds_file("# comment\nkaratsuba 77\n");
+    custom.karatsuba = 77;
+    total++;
+    if (bigint_load_thresholds(THRESHOLDS_FILE_PATH) != TRUE)
+        failed++;
+    bigint_get_thresholds(&loaded);
+    if (memcmp(&loaded, &custom, sizeof(Thresholds)) != 0)
+        failed++;
+
+    /* Values go through the checks of bigint_set_thresholds */
+    write_thresholds_file("toom3 0\nnewton 1\nburnikel_ziegler 0\nunbalanced_ratio 0\n");
+    bigint_load_thresholds(THRESHOLDS_FILE_PATH);
+    bigint_get_thresholds(&loaded);
+    total++;
+    if (loaded.toom3 < 2 || loaded.newton < 3 || loaded.burnikel_ziegler < 2 || loaded.unbalanced_ratio < 2)
+        failed++;
+
+    /* A file for another word size and a missing file leave the thresholds unchanged */
+    bigint_set_thresholds(&custom);
+    snprintf(contents, sizeof(contents), "word_bitlen %zu\nkaratsuba 5\n", (size_t)BITLEN_OF_WORD * 2);
+    write_thresholds_file(contents);
+    total++;
+    if (bigint_load_thresholds(THRESHOLDS_FILE_PATH) != FALSE)
+        failed++;
+    remove(THRESHOLDS_FILE_PATH);
+    if (bigint_load_thresholds(THRESHOLDS_FILE_PATH) != FALSE)
+        failed++;
+    bigint_get_thresholds(&loaded);
+    if (memcmp(&loaded, &custom, sizeof(Thresholds)) != 0)
+        failed++;
+
+    bigint_set_thresholds(&original);
+
+    return report(name, total, failed);
+}
+
+/* random word: whole words of random bytes */
+static Word generate_random_word(void)
+{
+    Word word = 0;
+
+    for (size_t idx = 0; idx < SIZE_OF_WORD; idx++)
+        word = (Word)((word << 8) | (Word)(rand() & MASK8BIT));
+
+    return word;
+}
+
+/**
+ * @brief Checks word_division_double and word_division_double_preinv against bigint_division_binary_long.
+ * 
+ * The dividends are high*W + low with high < divisor, and the divisors are random,
+ * normalized (for the reciprocal), or at the edges: one, the top bit only, and all ones.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_word_division()
+{
+    const char* name = "word_division_double and word_division_double_preinv";
+    const Word top_bit = (Word)1 << (BITLEN_OF_WORD - 1);
+    Bigint* dividend = NULL;
+    Bigint* divisor_bigint = NULL;
+    Bigint* quotient = NULL;
+    Bigint* remainder = NULL;
+    size_t total = 0, failed = 0;
+
+    for (int trial = 0; trial < 3000; trial++)
+    {
+        Word divisor = generate_random_word();
+        if (trial % 3 == 1) divisor |= top_bit;
+        if (trial == 0) divisor = 1;
+        if (trial == 3) divisor = top_bit;
+        if (trial == 6) divisor = (Word)-1;
+        if (divisor == 0) divisor = 1;
+
+        Word dividend_high = generate_random_word() % divisor;
+        Word dividend_low = generate_random_word();
+        if (trial % 5 == 0) { // the largest quotient and remainder
+            dividend_high = divisor - 1;
+            dividend_low = (Word)-1;
+        }
+
+        /* Expected results */
+        bigint_new(&dividend, 2);
+        dividend->digits[0] = dividend_low;
+        dividend->digits[1] = dividend_high;
+        bigint_refine(dividend);
+        bigint_new(&divisor_bigint, 1);
+        divisor_bigint->digits[0] = divisor;
+        bigint_division_binary_long(&quotient, &remainder, dividend, divisor_bigint);
+
+        Word word_remainder;
+        Word word_quotient = word_division_double(&word_remainder, dividend_high, dividend_low, divisor);
+        total++;
+        if (quotient->digit_num != 1 || word_quotient != quotient->digits[0] || word_remainder != remainder->digits[0])
+            record_failure(name, &failed, dividend, divisor_bigint);
+
+        if ((divisor & top_bit) == 0) continue;
+
+        word_quotient = word_division_double_preinv(&word_remainder, dividend_high, dividend_low, divisor, word_reciprocal(divisor));
+        total++;
+        if (word_quotient != quotient->digits[0] || word_remainder != remainder->digits[0])
+            record_failure(name, &failed, dividend, divisor_bigint);
+    }
+
+    bigint_delete(&dividend);
+    bigint_delete(&divisor_bigint);
+    bigint_delete(&quotient);
+    bigint_delete(&remainder);
+
+    return report(name, total, failed);
+}
+
+/* number of allocations of bigint_multiplication with the thresholds, after the arena is freed */
+static size_t count_dispatch_allocations(const Thresholds* thresholds, Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    static AllocationCounter counter;
+    Thresholds thresholds_in_use;
+
+    bigint_get_thresholds(&thresholds_in_use);
+    bigint_set_thresholds(thresholds);
+
+    memset(&counter, 0, sizeof(counter));
+    bigint_scratch_free();
+    bigint_set_allocator(counting_alloc, counting_realloc, counting_free, &counter);
+    bigint_multiplication(result, operand_x, operand_y);
+    bigint_scratch_free();
+    bigint_set_allocator(NULL, NULL, NULL, NULL);
+
+    bigint_set_thresholds(&thresholds_in_use);
+
+    return counter.allocations + counter.reallocations;
+}
+
+/**
+ * @brief Checks that bigint_multiplication honors every threshold, whatever order the values are in.
+ * 
+ * Textbook and Comba multiply into a result of the right capacity without any allocation,
+ * while the NTT and Toom-Cook carve temporaries from the scratch arena. So with the arena
+ * freed, a tier set below the Karatsuba and Comba thresholds (the NTT, or Toom-Cook with
+ * 7 points below Toom-Cook with 5 points) must allocate. Then the products are checked
+ * with the thresholds in random orders.
+ * 
+ * @return size_t Number of failed checks.
+ */
+size_t bigint_test_dispatch()
+{
+    const char* name = "multiplication (thresholds out of order)";
+    static const size_t lengths[][2] = { {20, 20}, {40, 17}, {100, 100}, {300, 40}, {700, 650} };
+    Thresholds thresholds, disordered;
+    Bigint* operand_x = NULL;
+    Bigint* operand_y = NULL;
+    Bigint* result = NULL;
+    Bigint* expected = NULL;
+    size_t total = 0, failed = 0;
+
+    bigint_get_thresholds(&thresholds);
+    bigint_generate_random_number(&operand_x, POSITIVE, 100);
+    bigint_generate_random_number(&operand_y, NEGATIVE, 100);
+    bigint_new(&result, 200);
+
+    /* All tiers off: textbook allocates nothing */
+    disordered = thresholds;
+    disordered.comba = disordered.karatsuba = disordered.toom3 = disordered.toom4 = disordered.ntt = (size_t)-1;
+    total++;
+    if (count_dispatch_allocations(&disordered, &result, operand_x, operand_y) != 0)
+        record_failure(name, &failed, operand_x, operand_y);
+
+    /* NTT below Karatsuba and Comba */
+    disordered.ntt = 64;
+    total++;
+    if (count_dispatch_allocations(&disordered, &result, operand_x, operand_y) == 0)
+        record_failure(name, &failed, operand_x, operand_y);
+
+    /* Toom-Cook with 7 points below Toom-Cook with 5 points, Karatsuba and Comba */
+    disordered.ntt = (size_t)-1;
+    disordered.toom4 = 64;
+    total++;
+    if (count_dispatch_allocations(&disordered, &result, operand_x, operand_y) == 0)
+        record_failure(name, &failed, operand_x, operand_y);
+
+    /* Products with the thresholds in random orders */
+    for (int trial = 0; trial < 20; trial++)
+    {
+        size_t values[] = { 4, 8, 16, 32, 64, 128 };
+        size_t* fields[] = { &disordered.comba, &disordered.karatsuba, &disordered.toom3, &disordered.toom4, &disordered.ntt, &disordered.unbalanced_ratio };
+        size_t field_num = sizeof(fields) / sizeof(fields[0]);
+
+        disordered = thresholds;
+        for (size_t idx = field_num; idx > 1; idx--) {
+            size_t swap_idx = (size_t)rand() % idx;
+            size_t tmp = values[idx - 1]; values[idx - 1] = values[swap_idx]; values[swap_idx] = tmp;
+        }
+        for (size_t idx = 0; idx < field_num; idx++)
+            *fields[idx] = values[idx];
+
+        for (size_t idx = 0; idx < sizeof(lengths) / sizeof(lengths[0]); idx++)
+        {
+            generate_random_operand(&operand_x, lengths[idx][0]);
+            generate_random_operand(&operand_y, lengths[idx][1]);
+            multiplication_reference(&expected, operand_x, operand_y);
+
+            bigint_set_thresholds(&disordered);
+            bigint_multiplication(&result, operand_x, operand_y);
+            bigint_set_thresholds(&thresholds);
+
+            total++;
+            if (bigint_compare(result, expected) != SAME)
+                record_failure(name, &failed, operand_x, operand_y);
+        }
+    }
+
+    bigint_delete(&operand_x);
+    bigint_delete(&operand_y);
+    bigint_delete(&result);
+    bigint_delete(&expected);
+
+    return report(name, total, failed);
+}
@@ -9,10 +9,28 @@
 
 #define RESULT_FILE_PATH_Q "test/_tv_result_q.txt"
 #define RESULT_FILE_PATH_R "test/_tv_result_r.txt"
+#define THRESHOLDS_FILE_PATH "test/_thresholds.txt" ///< Written and removed by bigint_test_thresholds.
 
 #define TEST_VECTOR_SIZE 512
+#define TEST_VECTOR_NUM 4225 ///< Number of operand pairs in tv_x.txt and tv_y.txt.
+
+// Known results of the test vectors, e.g. "test/tv_mul_pn.txt" (positive x, negative y).
+#define KNOWN_RESULT_FILE_PATH "test/tv_%s_%s.txt"
 
 void bigint_test();
 void bigint_test_div();
 
+/* Checks against known results: each returns the number of failed checks */
+size_t bigint_test_multiplication();
+size_t bigint_test_dispatch();
+size_t bigint_test_division();
+size_t bigint_test_thresholds();
+size_t bigint_test_word();
+size_t bigint_test_word_division();
+size_t bigint_test_inplace();
+size_t bigint_test_handoff();
+size_t bigint_test_view();
+size_t bigint_test_scratch();
+size_t bigint_test_allocator();
+
 #endif
\ No newline at end of file
@@ -75,5 +75,18 @@ int main()
 
     bigint_test_div();
 
-    return 0;
+    size_t failed = 0;
+    failed += bigint_test_multiplication();
+    failed += bigint_test_dispatch();
+    failed += bigint_test_division();
+    failed += bigint_test_thresholds();
+    failed += bigint_test_word();
+    failed += bigint_test_word_division();
+    failed += bigint_test_inplace();
+    failed += bigint_test_handoff();
+    failed += bigint_test_view();
+    failed += bigint_test_scratch();
+    failed += bigint_test_allocator();
+
+    return (failed == 0) ? 0 : 1;
 }
\ No newline at end of file
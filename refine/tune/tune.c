@@ -0,0 +1,317 @@
+#include "../autobahn.h"
+#include <time.h>
+
+// gcc -O2 tune.c ../autobahn_*.c -o tune
+// ./tune [config file] [header file]
+
+#define CONFIG_FILE_PATH "autobahn_thresholds.conf"
+#define HEADER_FILE_PATH "autobahn_thresholds.h"
+
+#define TRIAL_NUM 5             ///< Each timing is the best of this many trials.
+#define TRIAL_TIME_MIN 2e-3     ///< A trial repeats the operation for at least this many seconds.
+#define WIN_NUM 3               ///< The faster algorithm must win at this many sizes in a row.
+#define UNTUNED ((size_t)-1)    ///< Threshold of a tier that is not tuned yet: never used.
+#define NEWTON_SIZE_MAX 32768   ///< Newton division is measured up to this length of the divisor.
+
+typedef void (*MultiplicationFunction)(Bigint** result, const Bigint* operand_x, const Bigint* operand_y);
+
+typedef enum {
+    OPERANDS_BALANCED, ///< Two operands of the same length.
+    OPERANDS_SQUARE,   ///< The same operand twice.
+    OPERANDS_DIVISION  ///< A dividend twice as long as the divisor.
+} OperandShape;
+
+static Bigint* division_remainder = NULL; ///< Remainder of the divisions measured, not allocated at each call.
+
+static void squaring_textbook(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    (void)operand_y;
+    bigint_squaring_textbook(result, operand_x);
+}
+
+static void squaring_karatsuba(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    (void)operand_y;
+    bigint_squaring_karatsuba(result, operand_x);
+}
+
+static void squaring(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    (void)operand_y;
+    bigint_squaring(result, operand_x);
+}
+
+static void division(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_division(result, &division_remainder, operand_x, operand_y);
+}
+
+static void division_word_long(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    bigint_division_word_long(result, &division_remainder, operand_x, operand_y);
+}
+
+/**
+ * @brief Burnikel-Ziegler with one level of recursion: the halves of the divisor are divided by Algorithm D.
+ */
+static void division_burnikel_ziegler(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    Thresholds thresholds;
+    size_t threshold;
+
+    bigint_get_thresholds(&thresholds);
+    threshold = thresholds.burnikel_ziegler;
+    thresholds.burnikel_ziegler = operand_y->digit_num;
+    bigint_set_thresholds(&thresholds);
+
+    bigint_division_burnikel_ziegler(result, &division_remainder, operand_x, operand_y);
+
+    thresholds.burnikel_ziegler = threshold;
+    bigint_set_thresholds(&thresholds);
+}
+
+/**
+ * @brief Newton division with Newton iteration at the top level of the reciprocal only.
+ */
+static void division_newton(Bigint** result, const Bigint* operand_x, const Bigint* operand_y)
+{
+    Thresholds thresholds;
+    size_t threshold;
+
+    bigint_get_thresholds(&thresholds);
+    threshold = thresholds.newton;
+    thresholds.newton = operand_y->digit_num;
+    bigint_set_thresholds(&thresholds);
+
+    bigint_division_newton(result, &division_remainder, operand_x, operand_y);
+
+    thresholds.newton = threshold;
+    bigint_set_thresholds(&thresholds);
+}
+
+static double seconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Measures the time of one call of [function], in seconds.
+ *
+ * The best of TRIAL_NUM trials is taken, so other processes disturb the result less.
+ */
+static double measure(MultiplicationFunction function, const Bigint* operand_x, const Bigint* operand_y)
+{
+    Bigint* result = NULL;
+    double best = 0;
+
+    for (int trial = 0; trial < TRIAL_NUM; trial++) {
+        size_t count = 0;
+        double start = seconds();
+        double elapsed;
+
+        do {
+            function(&result, operand_x, operand_y);
+            count++;
+            elapsed = seconds() - start;
+        } while (elapsed < TRIAL_TIME_MIN);
+
+        if (trial == 0 || elapsed / count < best)
+            best = elapsed / count;
+    }
+
+    bigint_delete(&result);
+    return best;
+}
+
+/**
+ * @brief Finds the size from which [fast] beats [slow].
+ *
+ * The sizes grow by [step] from [start] to [end]. The crossover is the first size of
+ * WIN_NUM wins of [fast] in a row, so a single noisy timing does not decide it.
+ * For squaring, the same operand is given twice. For division, the size is the length of the divisor.
+ *
+ * @return size_t The crossover, or [end] if [fast] does not win below [end].
+ */
+static size_t find_crossover(const char* name, MultiplicationFunction slow, MultiplicationFunction fast,
+                             size_t start, size_t end, double step, OperandShape shape)
+{
+    size_t win_start = 0;
+    size_t win_num = 0;
+
+    for (size_t digit_num = start; digit_num < end; digit_num = (size_t)(digit_num * step) + 1) {
+        Bigint* operand_x = NULL;
+        Bigint* operand_y = NULL;
+
+        bigint_generate_random_number(&operand_x, POSITIVE, (shape == OPERANDS_DIVISION) ? digit_num * 2 : digit_num);
+        bigint_generate_random_number(&operand_y, POSITIVE, digit_num);
+        if (shape == OPERANDS_SQUARE)
+            bigint_copy(&operand_y, operand_x);
+
+        const Bigint* second = (shape == OPERANDS_SQUARE) ? operand_x : operand_y;
+        double time_slow = measure(slow, operand_x, second);
+        double time_fast = measure(fast, operand_x, second);
+
+        printf("%-20s %8zu digits: %12.3f us %12.3f us\n", name, digit_num, time_slow * 1e6, time_fast * 1e6);
+        bigint_delete(&operand_x);
+        bigint_delete(&operand_y);
+
+        if (time_fast < time_slow) {
+            if (win_num++ == 0)
+                win_start = digit_num;
+            if (win_num == WIN_NUM)
+                return win_start;
+        } else {
+            win_num = 0;
+        }
+    }
+
+    return end;
+}
+
+/**
+ * @brief Finds the ratio of lengths from which bigint_multiplication_unbalanced beats the balanced tiers.
+ *
+ * @param digit_num [input] Length of the shorter operand.
+ * @param ratio_max [input] Ratio returned if the split never wins.
+ */
+static size_t find_unbalanced_ratio(size_t digit_num, size_t ratio_max)
+{
+    for (size_t ratio = 2; ratio < ratio_max; ratio++) {
+        Bigint* operand_x = NULL;
+        Bigint* operand_y = NULL;
+
+        bigint_generate_random_number(&operand_x, POSITIVE, digit_num * ratio);
+        bigint_generate_random_number(&operand_y, POSITIVE, digit_num);
+
+        double time_balanced = measure(bigint_multiplication, operand_x, operand_y);
+        double time_split = measure(bigint_multiplication_unbalanced, operand_x, operand_y);
+
+        printf("%-20s %8zu x %zu: %12.3f us %12.3f us\n", "unbalanced_ratio", digit_num * ratio, digit_num,
+               time_balanced * 1e6, time_split * 1e6);
+        bigint_delete(&operand_x);
+        bigint_delete(&operand_y);
+
+        if (time_split < time_balanced)
+            return ratio;
+    }
+
+    return ratio_max;
+}
+
+/**
+ * @brief Writes the thresholds as the defaults of the library (build it with -DBI_TUNED_THRESHOLDS).
+ */
+static void write_header(const char* file_path, const Thresholds* thresholds)
+{
+    FILE* file = fopen(file_path, "w");
+
+    if (file == NULL) {
+        printf("cannot open %s\n", file_path);
+        return;
+    }
+
+    fprintf(file, "#ifndef AUTOBAHN_THRESHOLDS_H\n#define AUTOBAHN_THRESHOLDS_H\n\n");
+    fprintf(file, "// Written by tune for %zu-bit words. Thresholds are in digits.\n", (size_t)BITLEN_OF_WORD);
+    fprintf(file, "#define COMBA_THRESHOLD %zu\n", thresholds->comba);
+    fprintf(file, "#define KARATSUBA_THRESHOLD %zu\n", thresholds->karatsuba);
+    fprintf(file, "#define TOOM3_THRESHOLD %zu\n", thresholds->toom3);
+    fprintf(file, "#define TOOM4_THRESHOLD %zu\n", thresholds->toom4);
+    fprintf(file, "#define NTT_THRESHOLD %zu\n", thresholds->ntt);
+    fprintf(file, "#define UNBALANCED_RATIO %zu\n", thresholds->unbalanced_ratio);
+    fprintf(file, "#define SQUARING_KARATSUBA_THRESHOLD %zu\n", thresholds->squaring_karatsuba);
+    fprintf(file, "#define SQUARING_TOOM3_THRESHOLD %zu\n", thresholds->squaring_toom3);
+    fprintf(file, "#define SQUARING_TOOM4_THRESHOLD %zu\n", thresholds->squaring_toom4);
+    fprintf(file, "#define SQUARING_NTT_THRESHOLD %zu\n", thresholds->squaring_ntt);
+    fprintf(file, "#define BURNIKEL_ZIEGLER_THRESHOLD %zu\n", thresholds->burnikel_ziegler);
+    fprintf(file, "#define NEWTON_THRESHOLD %zu\n", thresholds->newton);
+    fprintf(file, "\n#endif\n");
+
+    fclose(file);
+}
+
+/**
+ * @brief Measures the crossovers of bigint_multiplication, bigint_squaring and bigint_division on this machine.
+ *
+ * Tiers are tuned from the bottom up. While a tier is tuned, it and the tiers above it are
+ * disabled, so the algorithm compared at the top level recurses into the tiers tuned so far.
+ * The thresholds are written as a config file for bigint_load_thresholds
+ * and as a header for -DBI_TUNED_THRESHOLDS. Division is tuned last, since it multiplies.
+ */
+int main(int argc, char* argv[])
+{
+    const char* config_path = (argc > 1) ? argv[1] : CONFIG_FILE_PATH;
+    const char* header_path = (argc > 2) ? argv[2] : HEADER_FILE_PATH;
+    Thresholds thresholds;
+    Thresholds defaults;
+
+    srand((unsigned)time(NULL));
+    bigint_get_thresholds(&defaults);
+    thresholds = defaults;
+    thresholds.karatsuba = thresholds.toom3 = thresholds.toom4 = thresholds.ntt = UNTUNED;
+    thresholds.squaring_karatsuba = thresholds.squaring_toom3 = thresholds.squaring_toom4 = thresholds.squaring_ntt = UNTUNED;
+    thresholds.unbalanced_ratio = thresholds.burnikel_ziegler = thresholds.newton = UNTUNED;
+    bigint_set_thresholds(&thresholds);
+
+    printf("%-20s %8s          %15s %15s\n", "threshold", "size", "slower tier", "new tier");
+
+    /* Multiplication */
+    thresholds.comba = find_crossover("comba", bigint_multiplication_textbook, bigint_multiplication_comba, 2, 128, 1.2, OPERANDS_BALANCED);
+    bigint_set_thresholds(&thresholds);
+
+    thresholds.karatsuba = find_crossover("karatsuba", bigint_multiplication, bigint_multiplication_karatsuba, 8, 1024, 1.1, OPERANDS_BALANCED);
+    bigint_set_thresholds(&thresholds);
+
+    thresholds.toom3 = find_crossover("toom3", bigint_multiplication, bigint_multiplication_toom3, thresholds.karatsuba, 4096, 1.1, OPERANDS_BALANCED);
+    bigint_set_thresholds(&thresholds);
+
+    thresholds.toom4 = find_crossover("toom4", bigint_multiplication, bigint_multiplication_toom4, thresholds.toom3, 8192, 1.1, OPERANDS_BALANCED);
+    bigint_set_thresholds(&thresholds);
+
+    thresholds.ntt = find_crossover("ntt", bigint_multiplication, bigint_multiplication_ntt, thresholds.toom4, 262144, 1.2, OPERANDS_BALANCED);
+    bigint_set_thresholds(&thresholds);
+
+    thresholds.unbalanced_ratio = find_unbalanced_ratio(thresholds.toom3 * 2, 16);
+    bigint_set_thresholds(&thresholds);
+
+    /* Squaring */
+    thresholds.squaring_karatsuba = find_crossover("squaring_karatsuba", squaring_textbook, squaring_karatsuba, 4, 1024, 1.1, OPERANDS_SQUARE);
+    bigint_set_thresholds(&thresholds);
+
+    thresholds.squaring_toom3 = find_crossover("squaring_toom3", squaring, bigint_multiplication_toom3, thresholds.squaring_karatsuba, 4096, 1.1, OPERANDS_SQUARE);
+    bigint_set_thresholds(&thresholds);
+
+    thresholds.squaring_toom4 = find_crossover("squaring_toom4", squaring, bigint_multiplication_toom4, thresholds.squaring_toom3, 8192, 1.1, OPERANDS_SQUARE);
+    bigint_set_thresholds(&thresholds);
+
+    thresholds.squaring_ntt = find_crossover("squaring_ntt", squaring, bigint_multiplication_ntt, thresholds.squaring_toom4, 262144, 1.2, OPERANDS_SQUARE);
+    bigint_set_thresholds(&thresholds);
+
+    /* Division */
+    thresholds.burnikel_ziegler = find_crossover("burnikel_ziegler", division_word_long, division_burnikel_ziegler, 8, 4096, 1.1, OPERANDS_DIVISION);
+    bigint_set_thresholds(&thresholds);
+
+    /* Newton needs a fast multiplication to beat Burnikel-Ziegler: keep the default if it does not win */
+    thresholds.newton = find_crossover("newton", division, division_newton, thresholds.burnikel_ziegler * 4, NEWTON_SIZE_MAX, 1.3, OPERANDS_DIVISION);
+    if (thresholds.newton >= NEWTON_SIZE_MAX)
+        thresholds.newton = defaults.newton;
+    bigint_set_thresholds(&thresholds);
+
+    /* Results */
+    bigint_get_thresholds(&thresholds);
+    printf("\ncomba %zu, karatsuba %zu, toom3 %zu, toom4 %zu, ntt %zu, unbalanced_ratio %zu\n",
+           thresholds.comba, thresholds.karatsuba, thresholds.toom3, thresholds.toom4, thresholds.ntt, thresholds.unbalanced_ratio);
+    printf("squaring: karatsuba %zu, toom3 %zu, toom4 %zu, ntt %zu\n",
+           thresholds.squaring_karatsuba, thresholds.squaring_toom3, thresholds.squaring_toom4, thresholds.squaring_ntt);
+    printf("division: burnikel_ziegler %zu, newton %zu\n", thresholds.burnikel_ziegler, thresholds.newton);
+
+    if (bigint_save_thresholds(config_path))
+        printf("wrote %s\n", config_path);
+    write_header(header_path, &thresholds);
+    printf("wrote %s\n", header_path);
+
+    bigint_delete(&division_remainder);
+    bigint_scratch_free();
+    return 0;
+}